@@ -0,0 +1,1793 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BinPacking/BinPacking.h"
+#include "Individuals/SharedGenomeIndividual.h"
+#include "Populations/ContiguousPopulation.h"
+#include "Operators/SegmentXOver.h"
+#include "Operators/TwoPtXOver.h"
+#include "Operators/UniformXOver.h"
+#include "Selectors/StochasticUniversalSampler.h"
+#include "SGA/SGA.h"
+#include "StaticEvolutionaryAlgorithm.h"
+#include "Utils/Benchmarks.h"
+
+namespace
+{
+	std::atomic<size_t> allocations_count{ 0 };
+	std::atomic<size_t> allocated_bytes{ 0 };
+}
+
+// GCC inlines the replacements into delete expressions, sees free called on memory from operator new
+// and warns with -Wmismatched-new-delete. The replacements are therefore never inlined.
+#if defined(_MSC_VER)
+#define BENCHMARKS_NOINLINE __declspec(noinline)
+#else
+#define BENCHMARKS_NOINLINE __attribute__((noinline))
+#endif
+
+// Count all heap allocations so that allocation-free code paths can be verified
+BENCHMARKS_NOINLINE void * operator new(const size_t size)
+{
+	++allocations_count;
+	allocated_bytes += size;
+
+	if (const auto pointer = std::malloc(size == 0 ? 1 : size))
+	{
+		return pointer;
+	}
+
+	throw std::bad_alloc{};
+}
+
+BENCHMARKS_NOINLINE void operator delete(void * pointer) noexcept
+{
+	std::free(pointer);
+}
+
+BENCHMARKS_NOINLINE void operator delete(void * pointer, size_t) noexcept
+{
+	std::free(pointer);
+}
+
+namespace
+{
+	/**
+	 * \brief Measures how the parallel fitness evaluation scales with the number of threads.
+	 *		  Both the per-individual and the split population modes are measured and compared to the serial results.
+	 * \param path Path to weights of items
+	 */
+	void benchmark_fitness_threads(const std::string & path)
+	{
+		using individual_type = ea::GenericIndividual<std::vector<int>, double>;
+		using population_type = std::vector<individual_type>;
+
+		const size_t bins_count = 7;
+		const size_t pop_size = 10000;
+		const auto repetitions = 20;
+
+		const auto weights = bin_packing::load_weights(path);
+		bin_packing::BinPackingFitness<population_type> fitness(weights, bins_count);
+		auto population = ea::init_pop_uniform_int<population_type>(0, bins_count - 1, pop_size, weights.size());
+
+		fitness(population);
+		std::vector<double> expected;
+
+		for (auto && individual : population)
+		{
+			expected.push_back(individual.fitness);
+		}
+
+		const auto max_threads = (std::max)(1u, std::thread::hardware_concurrency());
+
+		std::cout << "Fitness evaluation - " << path << ", population: " << pop_size << ", repetitions: " << repetitions << std::endl;
+
+		for (auto individual_mode : { true, false })
+		{
+			std::cout << (individual_mode ? "Per-individual evaluation" : "Split population evaluation") << std::endl;
+
+			for (size_t threads = 1; threads <= max_threads; threads *= 2)
+			{
+				ea::EvolutionaryAlgorithm<population_type> ea;
+				ea.set_fitness(fitness);
+
+				if (individual_mode)
+				{
+					ea.set_individual_fitness(fitness);
+				}
+
+				ea.set_fitness_threads(threads);
+
+				for (auto && individual : population)
+				{
+					individual.fitness = 0;
+				}
+
+				const auto time_total_ms = ea::benchmark_fitness(ea, population, repetitions);
+				auto identical = true;
+
+				for (size_t i = 0; i < population.size(); ++i)
+				{
+					identical = identical && population[i].fitness == expected[i];
+				}
+
+				std::cout << "Threads: " << threads << ", total ms: " << time_total_ms << ", ms per evaluation: " << (time_total_ms / static_cast<double>(repetitions)) << ", identical: " << (identical ? "yes" : "NO") << std::endl;
+			}
+		}
+	}
+
+	/**
+	 * \brief Measures how the wall-clock time of evolve_batch scales with the number of batch threads.
+	 * \param path Path to weights of items
+	 */
+	void benchmark_batch_threads(const std::string & path)
+	{
+		using individual_type = ea::GenericIndividual<std::vector<int>, double>;
+		using population_type = std::vector<individual_type>;
+
+		const size_t bins_count = 7;
+		const size_t pop_size = 100;
+		const size_t generations = 500;
+		const size_t runs = 16;
+
+		const auto weights = bin_packing::load_weights(path);
+		bin_packing::BinPackingFitness<population_type> fitness(weights, bins_count);
+		const auto max_threads = (std::max)(1u, std::thread::hardware_concurrency());
+
+		std::cout << "Batch runs - " << path << ", runs: " << runs << ", generations: " << generations << std::endl;
+
+		for (size_t threads = 1; threads <= max_threads; threads *= 2)
+		{
+			ea::EvolutionaryAlgorithm<population_type> ea;
+			ea.add_operator(ea::OnePtXOver<population_type>(0.2));
+			ea.add_operator(ea::IntegerMutation<population_type>(0, bins_count - 1, 0.6, 0.001));
+			ea.add_mating_selector(ea::TournamentSelector<population_type>());
+			ea.add_natural_selector(ea::TournamentSelector<population_type>());
+			ea.set_elitism(0.05);
+			ea.set_fitness(fitness);
+			ea.set_output_frequency(0);
+			ea.set_seed(42);
+			ea.set_batch_threads(threads);
+
+			// Silence the progress output of individual runs
+			std::ostringstream silent;
+			const auto original_buffer = std::cout.rdbuf(silent.rdbuf());
+
+			const auto time_start = GetTimeMs64();
+			ea.evolve_batch(generations, runs, [&]() { return ea::init_pop_uniform_int<population_type>(0, bins_count - 1, pop_size, weights.size()); });
+			const auto time_total_ms = GetTimeMs64() - time_start;
+
+			std::cout.rdbuf(original_buffer);
+
+			std::cout << "Threads: " << threads << ", total ms: " << time_total_ms << ", ms per run: " << (time_total_ms / static_cast<double>(runs)) << std::endl;
+		}
+	}
+
+	/**
+	 * \brief Counts heap allocations made by the generation loop once the buffers are warm.
+	 *		  Uses the bin packing configuration from main with the recycling population.
+	 * \param path Path to weights of items
+	 * \return Whether no allocations were made
+	 */
+	bool benchmark_allocations(const std::string & path)
+	{
+		using individual_type = bin_packing::BinPackingIndividual<std::vector<int>, double>;
+		using population_type = ea::RecyclingPopulation<individual_type>;
+
+		bin_packing::BinPackingSettings settings;
+		settings.mutation_probability = 0.6;
+		settings.crossover_probability = 0.2;
+		settings.gene_change_probability = 0.001;
+		settings.bins_count = 7;
+		settings.elitism = 0.05;
+
+		const size_t warm_up_generations = 20;
+		const size_t generations = 200;
+
+		const auto weights = bin_packing::load_weights(path);
+		bin_packing::BinPackingFitness<population_type> fitness(weights, settings.bins_count);
+		auto ea = bin_packing::create_algorithm(fitness, settings);
+		auto population = ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, settings.pop_size, weights.size());
+		population_type next_pop{};
+
+		for (size_t i = 0; i < warm_up_generations; ++i)
+		{
+			ea.evolve(population, next_pop);
+			std::swap(population, next_pop);
+		}
+
+		const auto allocations_before = allocations_count.load();
+
+		for (size_t i = 0; i < generations; ++i)
+		{
+			ea.evolve(population, next_pop);
+			std::swap(population, next_pop);
+		}
+
+		const auto allocations = allocations_count.load() - allocations_before;
+
+		std::cout << "Allocations - generations: " << generations << ", total allocations: " << allocations << ", allocations per generation: " << (allocations / static_cast<double>(generations)) << std::endl;
+
+		return allocations == 0;
+	}
+
+	/**
+	 * \brief Runs the simple genetic algorithm for a given individual type and measures the time of a generation.
+	 * \tparam TPopulation 
+	 * \param population Initial population
+	 * \param generations 
+	 * \return Total time in milliseconds
+	 */
+	template<typename TPopulation>
+	unsigned long long benchmark_sga(TPopulation population, const int generations)
+	{
+		ea::EvolutionaryAlgorithm<TPopulation> ea;
+		ea.add_operator(ea::BitFlipMutation<TPopulation>{ 0.01 });
+		ea.add_operator(ea::OnePtXOver<TPopulation>{ 0.6 });
+		ea.add_mating_selector(ea::TournamentSelector<TPopulation>{});
+		ea.set_individual_fitness(sga::OneMaxFitness<TPopulation>{});
+
+		return ea::benchmark(ea, population, generations);
+	}
+
+	/**
+	 * \brief Compares individuals with one byte per bit to packed bit individuals on long genomes.
+	 */
+	void benchmark_packed_bits()
+	{
+		using byte_individual_type = ea::GenericIndividual<std::vector<uint8_t>, int>;
+		using packed_individual_type = ea::PackedBitIndividual<int>;
+
+		const size_t pop_size = 20;
+		const auto generations = 20;
+
+		std::cout << "Packed bits - population: " << pop_size << ", generations: " << generations << std::endl;
+
+		for (size_t bits = 10000; bits <= 1000000; bits *= 10)
+		{
+			const auto byte_ms = benchmark_sga(ea::init_pop_uniform_bool<std::vector<byte_individual_type>>(pop_size, bits), generations);
+			const auto packed_ms = benchmark_sga(ea::init_pop_uniform_bits<std::vector<packed_individual_type>>(pop_size, bits), generations);
+
+			std::cout << "Bits: " << bits << ", byte per bit ms: " << byte_ms << ", packed ms: " << packed_ms << std::endl;
+		}
+	}
+
+	/**
+	 * \brief Mutates individuals that consist of zeros and collects histograms of the number of changed genes per individual
+	 *		  and of the positions of changed genes.
+	 * \tparam TOperator 
+	 * \tparam TPopulation 
+	 * \param mutation Operator that changes selected genes to a non-zero value
+	 * \param zeros Population of individuals that consist of zeros. It is copied before every mutation.
+	 * \param samples How many individuals should be mutated. A multiple of the size of zeros.
+	 * \param counts Histogram of the numbers of changed genes that is filled. The last bin collects all higher counts.
+	 * \param positions Histogram of the positions of changed genes that is filled. Its size is the size of individuals.
+	 * \return Total time in milliseconds
+	 */
+	template<typename TOperator, typename TPopulation>
+	unsigned long long collect_mutation_histograms(TOperator mutation, const TPopulation & zeros, const size_t samples, std::vector<size_t> & counts, std::vector<size_t> & positions)
+	{
+		unsigned long long time_total_ms = 0;
+
+		for (size_t sample = 0; sample < samples; sample += zeros.size())
+		{
+			auto population = zeros;
+
+			const auto time_start = GetTimeMs64();
+			mutation(population);
+			time_total_ms += GetTimeMs64() - time_start;
+
+			for (auto && individual : population)
+			{
+				size_t changed = 0;
+
+				for (size_t i = 0; i < individual.size(); ++i)
+				{
+					if (individual[i] != 0)
+					{
+						++changed;
+						++positions[i];
+					}
+				}
+
+				++counts[(std::min)(changed, counts.size() - 1)];
+			}
+		}
+
+		return time_total_ms;
+	}
+
+	/**
+	 * \brief Result of the two-sample chi-squared test.
+	 */
+	struct ChiSquaredTest
+	{
+		double statistic = 0;
+		size_t degrees_of_freedom = 0;
+		double critical_value = 0;
+
+		bool passed() const
+		{
+			return statistic <= critical_value;
+		}
+	};
+
+	/**
+	 * \brief Tests whether two histograms come from the same distribution with the two-sample chi-squared test at the significance 0.001.
+	 *		  Neighbouring bins are merged until both histograms expect at least 5 samples in them, so that the chi-squared approximation holds.
+	 * \param first 
+	 * \param second Histogram with the same bins
+	 * \return
+	 */
+	ChiSquaredTest chi_squared_test(const std::vector<size_t> & first, const std::vector<size_t> & second)
+	{
+		double first_total = 0;
+		double second_total = 0;
+
+		for (size_t i = 0; i < first.size(); ++i)
+		{
+			first_total += first[i];
+			second_total += second[i];
+		}
+
+		const auto first_scale = std::sqrt(second_total / first_total);
+		const auto second_scale = std::sqrt(first_total / second_total);
+		const auto min_expected = 5 * (first_total + second_total) / (std::min)(first_total, second_total);
+
+		ChiSquaredTest test;
+		double first_merged = 0;
+		double second_merged = 0;
+		size_t merged_bins = 0;
+
+		for (size_t i = 0; i < first.size(); ++i)
+		{
+			first_merged += first[i];
+			second_merged += second[i];
+
+			// The rest of the bins is merged to the last one
+			if (first_merged + second_merged < min_expected && i + 1 < first.size())
+			{
+				continue;
+			}
+
+			if (first_merged + second_merged > 0)
+			{
+				const auto difference = first_scale * first_merged - second_scale * second_merged;
+				test.statistic += difference * difference / (first_merged + second_merged);
+				++merged_bins;
+			}
+
+			first_merged = 0;
+			second_merged = 0;
+		}
+
+		test.degrees_of_freedom = merged_bins > 1 ? merged_bins - 1 : 1;
+
+		// The Wilson-Hilferty approximation of the quantile, 3.0902 is the 0.999 quantile of the standard normal distribution
+		const auto k = static_cast<double>(test.degrees_of_freedom);
+		const auto cube_root = 1 - 2 / (9 * k) + 3.0902 * std::sqrt(2 / (9 * k));
+		test.critical_value = k * cube_root * cube_root * cube_root;
+
+		return test;
+	}
+
+	/**
+	 * \brief Mutates populations with a tested and a reference operator and compares the numbers and positions of changed genes.
+	 * \tparam TOperator 
+	 * \tparam TPopulation 
+	 * \param name Name of the tested operator
+	 * \param mutation The tested operator
+	 * \param zeros Population of individuals that consist of zeros
+	 * \param reference_counts Histogram of the numbers of changed genes of the reference operator
+	 * \param reference_positions Histogram of the positions of changed genes of the reference operator
+	 * \param samples How many individuals should be mutated
+	 * \return Whether both histograms pass the chi-squared test
+	 */
+	template<typename TOperator, typename TPopulation>
+	bool compare_mutation(const std::string & name, TOperator mutation, const TPopulation & zeros, const std::vector<size_t> & reference_counts,
+		const std::vector<size_t> & reference_positions, const size_t samples)
+	{
+		std::vector<size_t> counts(reference_counts.size(), 0);
+		std::vector<size_t> positions(reference_positions.size(), 0);
+
+		const auto time_ms = collect_mutation_histograms(mutation, zeros, samples, counts, positions);
+		const auto counts_test = chi_squared_test(reference_counts, counts);
+		const auto positions_test = chi_squared_test(reference_positions, positions);
+		const auto passed = counts_test.passed() && positions_test.passed();
+
+		std::cout << "  " << name << " ms: " << time_ms
+			<< ", counts chi-squared: " << counts_test.statistic << " (df " << counts_test.degrees_of_freedom << ", critical " << counts_test.critical_value << ")"
+			<< ", positions chi-squared: " << positions_test.statistic << " (df " << positions_test.degrees_of_freedom << ", critical " << positions_test.critical_value << ")"
+			<< (passed ? "" : " FAILED") << std::endl;
+
+		return passed;
+	}
+
+	/**
+	 * \brief Checks that the skip sampling and the random masks of packed individuals choose genes with the same distribution as the per gene sampling.
+	 *		  The histograms of the numbers and of the positions of changed genes are compared with the two-sample chi-squared test.
+	 * \return Whether all tests passed
+	 */
+	bool benchmark_gene_sampling()
+	{
+		using individual_type = ea::GenericIndividual<std::vector<int>, double>;
+		using population_type = std::vector<individual_type>;
+		using packed_individual_type = ea::PackedBitIndividual<double>;
+		using packed_population_type = std::vector<packed_individual_type>;
+
+		const size_t individual_size = 499;
+		const size_t pop_size = 1000;
+		const size_t samples = 200000;
+		const size_t bins = 64;
+
+		const auto zeros = ea::init_pop_uniform_int<population_type>(0, 0, pop_size, individual_size);
+		const packed_population_type packed_zeros(pop_size, packed_individual_type(individual_size));
+
+		std::cout << "Gene sampling - genes: " << individual_size << ", samples: " << samples << std::endl;
+
+		ea::rng_seed(1);
+		auto passed = true;
+
+		for (auto probability : { 0.001, 0.01, 0.05 })
+		{
+			std::cout << "Probability: " << probability << std::endl;
+
+			std::vector<size_t> integer_counts(bins, 0);
+			std::vector<size_t> integer_positions(individual_size, 0);
+			const auto integer_ms = collect_mutation_histograms(ea::IntegerMutation<population_type>(1, 1, 1, probability, ea::GeneSampling::per_gene), zeros, samples, integer_counts, integer_positions);
+			std::cout << "  Integer per gene ms: " << integer_ms << std::endl;
+
+			passed = compare_mutation("Integer skip", ea::IntegerMutation<population_type>(1, 1, 1, probability, ea::GeneSampling::skip), zeros, integer_counts, integer_positions, samples) && passed;
+
+			std::vector<size_t> bit_counts(bins, 0);
+			std::vector<size_t> bit_positions(individual_size, 0);
+			const auto bit_ms = collect_mutation_histograms(ea::BitFlipMutation<population_type>(probability, ea::GeneSampling::per_gene), zeros, samples, bit_counts, bit_positions);
+			std::cout << "  Bit flip per gene ms: " << bit_ms << std::endl;
+
+			passed = compare_mutation("Bit flip skip", ea::BitFlipMutation<population_type>(probability, ea::GeneSampling::skip), zeros, bit_counts, bit_positions, samples) && passed;
+			passed = compare_mutation("Bit flip packed masks", ea::BitFlipMutation<packed_population_type>(probability, ea::GeneSampling::per_gene), packed_zeros, bit_counts, bit_positions, samples) && passed;
+			passed = compare_mutation("Bit flip packed skip", ea::BitFlipMutation<packed_population_type>(probability, ea::GeneSampling::skip), packed_zeros, bit_counts, bit_positions, samples) && passed;
+		}
+
+		std::cout << "Gene sampling - checks " << (passed ? "passed" : "FAILED") << std::endl;
+
+		return passed;
+	}
+
+	/**
+	 * \brief Applies a crossover operator to a population repeatedly and measures the time.
+	 * \tparam TPopulation 
+	 * \tparam TOperator 
+	 * \param crossover 
+	 * \param population 
+	 * \param repetitions 
+	 * \return Total time in milliseconds
+	 */
+	template<typename TPopulation, typename TOperator>
+	unsigned long long time_crossover(TOperator crossover, TPopulation & population, const size_t repetitions)
+	{
+		const auto time_start = GetTimeMs64();
+
+		for (size_t i = 0; i < repetitions; ++i)
+		{
+			crossover(population);
+		}
+
+		return GetTimeMs64() - time_start;
+	}
+
+	/**
+	 * \brief Compares the in-place crossover operators with a one point crossover that swaps element by element.
+	 * \tparam TPopulation 
+	 * \param name Name of the genome type
+	 * \param individual_size 
+	 * \param repetitions How many times is each operator applied to the population
+	 */
+	template<typename TPopulation>
+	void benchmark_crossovers(const std::string & name, const size_t individual_size, const size_t repetitions)
+	{
+		const size_t pop_size = 100;
+		const auto probability = 1.0;
+		auto population = ea::init_pop_uniform_int<TPopulation>(0, 1, pop_size, individual_size);
+
+		auto elementwise = [&](TPopulation & pop)
+		{
+			std::uniform_int_distribution<size_t> int_distribution(0, individual_size - 1);
+
+			for (size_t i = 0; i < pop.size() / 2; ++i)
+			{
+				auto & p1 = pop[2 * i];
+				auto & p2 = pop[2 * i + 1];
+
+				for (auto j = int_distribution(ea::rng_gen()); j < p1.size(); ++j)
+				{
+					std::swap(p1[j], p2[j]);
+				}
+			}
+		};
+
+		const auto elementwise_ms = time_crossover(elementwise, population, repetitions);
+		const auto one_point_ms = time_crossover(ea::OnePtXOver<TPopulation>{ probability }, population, repetitions);
+		const auto two_point_ms = time_crossover(ea::TwoPtXOver<TPopulation>{ probability }, population, repetitions);
+		const auto segment_ms = time_crossover(ea::SegmentXOver<TPopulation>{ probability, individual_size / 4 }, population, repetitions);
+		const auto uniform_ms = time_crossover(ea::UniformXOver<TPopulation>{ probability }, population, repetitions);
+
+		std::cout << "Crossovers - genome: " << name << ", genes: " << individual_size << ", repetitions: " << repetitions
+			<< ", element by element ms: " << elementwise_ms << ", one point ms: " << one_point_ms << ", two point ms: " << two_point_ms
+			<< ", segment ms: " << segment_ms << ", uniform ms: " << uniform_ms << std::endl;
+	}
+
+	/**
+	 * \brief Lets a selector select a whole population repeatedly and measures the time.
+	 * \tparam TPopulation 
+	 * \tparam TSelector 
+	 * \param selector 
+	 * \param population 
+	 * \param repetitions 
+	 * \return Nanoseconds per selected individual
+	 */
+	template<typename TPopulation, typename TSelector>
+	double time_selection(TSelector selector, const TPopulation & population, const size_t repetitions)
+	{
+		TPopulation selected{};
+		selected.reserve(population.size());
+
+		const auto time_start = GetTimeMs64();
+
+		for (size_t i = 0; i < repetitions; ++i)
+		{
+			selected.clear();
+			selector(population, selected, population.size());
+		}
+
+		const auto time_total_ms = GetTimeMs64() - time_start;
+
+		return time_total_ms * 1e6 / (static_cast<double>(repetitions) * population.size());
+	}
+
+	/**
+	 * \brief Measures the time per selected individual of fitness proportionate selectors for population sizes from 10^2 to 10^6.
+	 *		  The linear scan of each draw that the roulette wheel used before is measured only for small populations.
+	 */
+	void benchmark_roulette_selection()
+	{
+		using individual_type = ea::GenericIndividual<std::array<int, 1>, double>;
+		using population_type = std::vector<individual_type>;
+
+		const size_t selections = 2000000;
+		const size_t linear_max_size = 10000;
+
+		auto linear = [](const population_type & from, population_type & to, const size_t count)
+		{
+			std::uniform_real_distribution<> real_distribution(0, 1);
+			double fitness_sum = 0;
+
+			for (auto && individual : from)
+			{
+				fitness_sum += individual.fitness;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const auto random = real_distribution(ea::rng_gen()) * fitness_sum;
+				double sum = 0;
+
+				for (auto && individual : from)
+				{
+					sum += individual.fitness;
+
+					if (random <= sum)
+					{
+						to.push_back(individual);
+						break;
+					}
+				}
+			}
+		};
+
+		for (size_t pop_size = 100; pop_size <= 1000000; pop_size *= 10)
+		{
+			auto population = ea::init_pop_uniform_int<population_type>(0, 0, pop_size, 1);
+			std::uniform_real_distribution<> fitness_distribution(0, 1);
+
+			for (auto && individual : population)
+			{
+				individual.fitness = fitness_distribution(ea::rng_gen());
+			}
+
+			const auto repetitions = (std::max)(size_t{ 1 }, selections / pop_size);
+
+			std::cout << "Roulette selection - population: " << pop_size << ", ns per selection - binary search: "
+				<< time_selection(ea::RouletteWheelSelector<population_type>{ ea::RouletteSampling::binary_search }, population, repetitions)
+				<< ", alias: " << time_selection(ea::RouletteWheelSelector<population_type>{ ea::RouletteSampling::alias }, population, repetitions)
+				<< ", stochastic universal: " << time_selection(ea::StochasticUniversalSampler<population_type>{}, population, repetitions);
+
+			if (pop_size <= linear_max_size)
+			{
+				std::cout << ", linear scan: " << time_selection(linear, population, (std::max)(size_t{ 1 }, repetitions * 100 / pop_size));
+			}
+
+			std::cout << std::endl;
+		}
+	}
+
+	/**
+	 * \brief Runs the bin packing algorithm with a given population type and measures the time and the allocated memory.
+	 * \tparam TPopulation 
+	 * \param name Name of the population type
+	 * \param weights Weights of items
+	 * \param settings 
+	 * \param generations 
+	 */
+	template<typename TPopulation>
+	void benchmark_bin_packing_population(const std::string & name, const std::vector<int> & weights, const bin_packing::BinPackingSettings & settings, const int generations)
+	{
+		using population_type = TPopulation;
+
+		bin_packing::BinPackingFitness<population_type> fitness(weights, settings.bins_count);
+		auto ea = bin_packing::create_algorithm(fitness, settings);
+		auto population = ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, settings.pop_size, weights.size());
+
+		const auto allocations_before = allocations_count.load();
+		const auto bytes_before = allocated_bytes.load();
+		const auto time_total_ms = ea::benchmark(ea, population, generations);
+		const auto allocations = allocations_count.load() - allocations_before;
+		const auto bytes = allocated_bytes.load() - bytes_before;
+
+		std::cout << "Genomes - population: " << name << ", generations: " << generations << ", total ms: " << time_total_ms
+			<< ", allocations per generation: " << (allocations / static_cast<double>(generations))
+			<< ", KB allocated per generation: " << (bytes / 1024.0 / generations) << std::endl;
+	}
+
+	/**
+	 * \brief Compares individuals that copy their genomes with individuals that share them until they are changed.
+	 *		  Uses the bin packing configuration from main, where most selected individuals are not changed by operators.
+	 * \param path Path to weights of items
+	 */
+	void benchmark_shared_genomes(const std::string & path)
+	{
+		bin_packing::BinPackingSettings settings;
+		settings.mutation_probability = 0.6;
+		settings.crossover_probability = 0.2;
+		settings.gene_change_probability = 0.001;
+		settings.gene_sampling = ea::GeneSampling::skip;
+		settings.bins_count = 7;
+		settings.elitism = 0.05;
+
+		const auto generations = 500;
+		const auto weights = bin_packing::load_weights(path);
+
+		benchmark_bin_packing_population<std::vector<ea::GenericIndividual<std::vector<int>, double>>>("copied", weights, settings, generations);
+		benchmark_bin_packing_population<std::vector<ea::SharedGenomeIndividual<std::vector<int>, double>>>("shared", weights, settings, generations);
+	}
+
+	/**
+	 * \brief Evolves the bin packing problem with a given population type the way evolve does (two populations that are swapped) and measures the time.
+	 * \tparam TPopulation 
+	 * \param name Name of the population type
+	 * \param weights Weights of items
+	 * \param settings 
+	 * \param generations 
+	 */
+	template<typename TPopulation>
+	void benchmark_generation_loop(const std::string & name, const std::vector<int> & weights, const bin_packing::BinPackingSettings & settings, const size_t generations)
+	{
+		bin_packing::BinPackingFitness<TPopulation> fitness(weights, settings.bins_count);
+		auto ea = bin_packing::create_algorithm(fitness, settings);
+		auto population = ea::init_pop_uniform_int<TPopulation>(0, settings.bins_count - 1, settings.pop_size, weights.size());
+		TPopulation next_pop{};
+
+		const auto time_start = GetTimeMs64();
+
+		for (size_t i = 0; i < generations; ++i)
+		{
+			ea.evolve(population, next_pop);
+			std::swap(population, next_pop);
+		}
+
+		const auto time_total_ms = GetTimeMs64() - time_start;
+
+		std::cout << "Populations - population: " << name << ", individuals: " << settings.pop_size << ", generations: " << generations
+			<< ", total ms: " << time_total_ms << ", best fitness: " << population[ea.best_index()].fitness << std::endl;
+	}
+
+	/**
+	 * \brief Compares populations of separately allocated genomes with the contiguous population on the bin packing problem.
+	 *		  Large populations are used so that the populations do not fit into caches.
+	 * \param path Path to weights of items
+	 */
+	void benchmark_contiguous_population(const std::string & path)
+	{
+		using individual_type = ea::GenericIndividual<std::vector<int>, double>;
+
+		bin_packing::BinPackingSettings settings;
+		settings.mutation_probability = 0.6;
+		settings.crossover_probability = 0.2;
+		settings.gene_change_probability = 0.001;
+		settings.gene_sampling = ea::GeneSampling::skip;
+		settings.bins_count = 7;
+		settings.elitism = 0.05;
+		settings.pop_size = 10000;
+
+		const size_t generations = 50;
+		const auto weights = bin_packing::load_weights(path);
+
+		benchmark_generation_loop<std::vector<individual_type>>("vector", weights, settings, generations);
+		benchmark_generation_loop<ea::RecyclingPopulation<individual_type>>("recycling", weights, settings, generations);
+		benchmark_generation_loop<ea::ContiguousPopulation<int, double>>("contiguous", weights, settings, generations);
+	}
+
+	/**
+	 * \brief Evolves a population the way evolve does (two populations that are swapped) and measures the time.
+	 * \tparam TEvolutionaryAlgorithm 
+	 * \tparam TPopulation 
+	 * \param ea 
+	 * \param population The initial population
+	 * \param generations 
+	 * \return Total time in milliseconds
+	 */
+	template<typename TEvolutionaryAlgorithm, typename TPopulation>
+	unsigned long long time_generations(TEvolutionaryAlgorithm & ea, TPopulation population, const size_t generations)
+	{
+		TPopulation next_pop{};
+
+		const auto time_start = GetTimeMs64();
+
+		for (size_t i = 0; i < generations; ++i)
+		{
+			ea.evolve(population, next_pop);
+			std::swap(population, next_pop);
+		}
+
+		return GetTimeMs64() - time_start;
+	}
+
+	/**
+	 * \brief Times two algorithms on the same population in alternating repetitions, so that both see the same state of the machine.
+	 * \tparam TDynamicAlgorithm 
+	 * \tparam TStaticAlgorithm 
+	 * \tparam TPopulation 
+	 * \param name Name of the configuration
+	 * \param dynamic_ea 
+	 * \param static_ea 
+	 * \param population The initial population
+	 * \param generations 
+	 */
+	template<typename TDynamicAlgorithm, typename TStaticAlgorithm, typename TPopulation>
+	void compare_pipelines(const std::string & name, TDynamicAlgorithm & dynamic_ea, TStaticAlgorithm & static_ea, const TPopulation & population, const size_t generations)
+	{
+		const size_t repetitions = 5;
+		std::vector<double> dynamic_ms;
+		std::vector<double> static_ms;
+
+		for (size_t i = 0; i < repetitions; ++i)
+		{
+			ea::rng_seed(1);
+			dynamic_ms.push_back(static_cast<double>(time_generations(dynamic_ea, population, generations)));
+			ea::rng_seed(1);
+			static_ms.push_back(static_cast<double>(time_generations(static_ea, population, generations)));
+		}
+
+		std::cout << "Pipeline - " << name << ", individuals: " << population.size() << ", generations: " << generations
+			<< ", median of " << repetitions << " std::function ms: " << ea::compute_statistics(dynamic_ms).median
+			<< ", static ms: " << ea::compute_statistics(static_ms).median << std::endl;
+	}
+
+	/**
+	 * \brief Compares the SGA configuration of solve_sga in the algorithm that calls its stages through std::function
+	 *		  and in the algorithm whose stages are fixed at compile time, which fuses the operators and the fitness.
+	 * \param size Number of bits of individuals
+	 * \param pop_size 
+	 * \param generations 
+	 * \param settings 
+	 */
+	void compare_sga_pipelines(const size_t size, const size_t pop_size, const size_t generations, const sga::SGASettings & settings)
+	{
+		using individual_type = ea::PackedBitIndividual<int>;
+		using population_type = std::vector<individual_type>;
+
+		ea::EvolutionaryAlgorithm<population_type> dynamic_ea{};
+		dynamic_ea.add_operator(ea::BitFlipMutation<population_type>{settings.bit_mutation_probability, settings.gene_sampling});
+		dynamic_ea.add_operator(ea::OnePtXOver<population_type>{settings.crossover_probability});
+		dynamic_ea.add_mating_selector(ea::RouletteWheelSelector<population_type>{});
+		dynamic_ea.set_individual_fitness(sga::OneMaxFitness<population_type>{});
+		dynamic_ea.set_elitism(settings.elitism);
+
+		auto static_ea = ea::make_static_algorithm<population_type>(sga::OneMaxFitness<population_type>{},
+			ea::make_stages(ea::RouletteWheelSelector<population_type>{}),
+			ea::make_stages(ea::BitFlipMutation<population_type>{settings.bit_mutation_probability, settings.gene_sampling}, ea::OnePtXOver<population_type>{settings.crossover_probability}));
+		static_ea.set_elitism(settings.elitism);
+
+		ea::rng_seed(1);
+		auto population = ea::init_pop_uniform_bits<population_type>(pop_size, size);
+		sga::OneMaxFitness<population_type>{}(population);
+
+		std::ostringstream name;
+		name << "SGA " << size << ", mutation probability " << settings.bit_mutation_probability;
+
+		compare_pipelines(name.str(), dynamic_ea, static_ea, population, generations);
+	}
+
+	/**
+	 * \brief Compares the algorithm that calls its stages through std::function with the algorithm whose stages are fixed at compile time.
+	 *		  The SGA configuration of solve_sga<70>, a big SGA population that does not fit in the cache
+	 *		  and the bin packing configuration of create_algorithm are measured.
+	 * \param path Path to weights of items
+	 */
+	void benchmark_static_pipeline(const std::string & path)
+	{
+		compare_sga_pipelines(70, sga::SGASettings{}.pop_size, 2000, sga::SGASettings{});
+
+		sga::SGASettings sparse_settings;
+		sparse_settings.bit_mutation_probability = 0.001;
+		sparse_settings.gene_sampling = ea::GeneSampling::skip;
+		compare_sga_pipelines(4096, 4000, 10, sparse_settings);
+
+		{
+			using individual_type = ea::GenericIndividual<std::vector<int>, double>;
+			using population_type = std::vector<individual_type>;
+
+			bin_packing::BinPackingSettings settings;
+			settings.mutation_probability = 0.6;
+			settings.crossover_probability = 0.2;
+			settings.gene_change_probability = 0.001;
+			settings.gene_sampling = ea::GeneSampling::skip;
+			settings.bins_count = 7;
+			settings.elitism = 0.05;
+
+			const size_t generations = 500;
+			const auto weights = bin_packing::load_weights(path);
+
+			bin_packing::BinPackingFitness<population_type> fitness(weights, settings.bins_count);
+			auto dynamic_ea = bin_packing::create_algorithm(fitness, settings);
+
+			auto static_ea = ea::make_static_algorithm<population_type>(fitness,
+				ea::make_stages(ea::TournamentSelector<population_type>(settings.tournament_size, settings.tournament_pressure)),
+				ea::make_stages(ea::OnePtXOver<population_type>(settings.crossover_probability),
+					ea::IntegerMutation<population_type>(0, settings.bins_count - 1, settings.mutation_probability, settings.gene_change_probability, settings.gene_sampling)),
+				ea::make_stages(ea::TournamentSelector<population_type>(settings.tournament_size, settings.tournament_pressure)));
+			static_ea.set_elitism(settings.elitism);
+
+			ea::rng_seed(1);
+			auto population = ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, settings.pop_size, weights.size());
+			fitness(population);
+
+			compare_pipelines("bin packing", dynamic_ea, static_ea, population, generations);
+		}
+	}
+
+	/**
+	 * \brief Checks that the local search gives the same population with 1 and 4 threads from the same seed,
+	 *		  and that the weights of bins of searched individuals match weights computed from their genes and only improve their objectives.
+	 * \param path Path to weights of items
+	 * \return Whether the checks passed
+	 */
+	bool local_search_matches(const std::string & path)
+	{
+		using individual_type = bin_packing::BinPackingIndividual<std::vector<uint8_t>, double>;
+		using population_type = ea::RecyclingPopulation<individual_type>;
+
+		const size_t bins_count = 7;
+		const auto weights = bin_packing::load_weights(path);
+		bin_packing::BinPackingFitness<population_type> fitness(weights, bins_count);
+
+		ea::rng_seed(42);
+		const auto original = ea::init_pop_uniform_int<population_type>(0, bins_count - 1, 100, weights.size());
+		std::vector<population_type> searched;
+
+		for (auto pool : { std::shared_ptr<ea::ThreadPool>{}, std::make_shared<ea::ThreadPool>(4) })
+		{
+			bin_packing::BinPackingLocalSearch<population_type> local_search(fitness, 0.5, 50, 16, pool);
+			auto population = original;
+			ea::rng_seed(7);
+			local_search(population);
+			searched.push_back(std::move(population));
+		}
+
+		auto matches = true;
+		size_t improved = 0;
+
+		for (size_t i = 0; i < original.size(); ++i)
+		{
+			matches = matches && std::equal(searched[0][i].begin(), searched[0][i].end(), searched[1][i].begin());
+
+			std::vector<int64_t> bin_weights(bins_count);
+
+			for (size_t item = 0; item < weights.size(); ++item)
+			{
+				bin_weights[searched[0][i][item]] += weights[item];
+			}
+
+			const auto objective = bin_packing::compute_objective(fitness.get_bin_weights(searched[0][i]));
+			const auto original_objective = bin_packing::compute_objective(fitness.get_bin_weights(original[i]));
+			matches = matches && fitness.get_bin_weights(searched[0][i]) == bin_weights && objective <= original_objective;
+			improved += objective < original_objective ? 1 : 0;
+		}
+
+		matches = matches && improved > 0;
+
+		std::cout << "Local search - improved individuals: " << improved << "/" << original.size() << ", 1 and 4 threads "
+			<< (matches ? "identical and weights of bins correct" : "DIFFER") << std::endl;
+
+		return matches;
+	}
+
+	/**
+	 * \brief Compares the time to reach a target objective of the bin packing algorithm of create_algorithm without
+	 *		  and with the local search of offspring. The targets are a nearly balanced assignment and the lower bound of the objective.
+	 *		  Also checks the local search itself (see local_search_matches).
+	 * \param path Path to weights of items
+	 * \return Whether the checks of the local search passed
+	 */
+	bool benchmark_local_search(const std::string & path)
+	{
+		const auto matches = local_search_matches(path);
+
+		using individual_type = bin_packing::BinPackingIndividual<std::vector<uint8_t>, double>;
+		using population_type = ea::RecyclingPopulation<individual_type>;
+
+		bin_packing::BinPackingSettings settings;
+		settings.mutation_probability = 0.6;
+		settings.crossover_probability = 0.2;
+		settings.gene_change_probability = 0.001;
+		settings.gene_sampling = ea::GeneSampling::skip;
+		settings.bins_count = 7;
+		settings.elitism = 0.05;
+		settings.output_frequency = 0;
+		settings.time_limit_ms = 2000;
+
+		const size_t runs = 3;
+		const size_t generations = 1000000; // Runs stop at the target or at the time limit
+		const auto weights = bin_packing::load_weights(path);
+		const auto lower_bound = bin_packing::objective_lower_bound(weights, settings.bins_count);
+
+		std::cout << "Local search - " << path << ", runs: " << runs << ", time limit ms: " << settings.time_limit_ms << std::endl;
+
+		for (auto target : { 5.0, lower_bound })
+		{
+			for (auto probability : { 0.0, 0.05, 0.2 })
+			{
+				settings.local_search_probability = probability;
+				bin_packing::BinPackingFitness<population_type> fitness(weights, settings.bins_count);
+				auto ea = bin_packing::create_algorithm(fitness, settings);
+				ea.set_target_objective(target);
+
+				size_t reached = 0;
+				double total_ms = 0;
+				size_t total_generations = 0;
+
+				for (size_t run = 0; run < runs; ++run)
+				{
+					ea::rng_seed(42, ea::StreamId{ run });
+					auto population = ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, settings.pop_size, weights.size());
+
+					std::ostringstream silent;
+					const auto time_start = std::chrono::steady_clock::now();
+					ea.evolve(std::move(population), generations, silent);
+					const auto time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+
+					// Runs that did not reach the target are counted with the time limit
+					const auto reason = ea.run_result().reason;
+					reached += reason == ea::StopReason::target_objective || reason == ea::StopReason::optimum ? 1 : 0;
+					total_ms += time_ms;
+					total_generations += ea.run_result().generations;
+				}
+
+				std::cout << "Local search - probability: " << probability << ", target objective: " << target << ", reached: " << reached << "/" << runs
+					<< ", mean ms: " << (total_ms / runs) << ", mean generations: " << (total_generations / static_cast<double>(runs)) << std::endl;
+			}
+		}
+
+		return matches;
+	}
+
+	/**
+	 * \brief Checks the SIMD kernels that compute weights of bins from genes of a given type against the scalar loop.
+	 * \tparam TGene Type of genes
+	 * \param max_weight Maximum weight of an item. Heavy items make the kernels add the sums of lanes to the weights of bins more often.
+	 * \return Whether all kernels computed the same weights as the scalar loop
+	 */
+	template<typename TGene>
+	bool bin_weights_kernels_match(const int max_weight)
+	{
+		using individual_type = ea::GenericIndividual<std::vector<TGene>, double>;
+		using population_type = std::vector<individual_type>;
+
+		const std::vector<std::string> level_names{ "scalar", "AVX2", "AVX-512" };
+		auto matches = true;
+
+		// Odd numbers of items leave tails that do not fill a whole vector
+		for (auto items_count : { size_t{ 1 }, size_t{ 13 }, size_t{ 499 }, size_t{ 1000 }, size_t{ 5000 } })
+		{
+			for (auto bins_count : { size_t{ 1 }, size_t{ 5 }, size_t{ 8 }, size_t{ 9 }, size_t{ 16 }, size_t{ 23 } })
+			{
+				std::vector<int> weights(items_count);
+				std::uniform_int_distribution<int> weight_distribution(1, max_weight);
+
+				for (auto && weight : weights)
+				{
+					weight = weight_distribution(ea::rng_gen());
+				}
+
+				auto population = ea::init_pop_uniform_int<population_type>(0, static_cast<int>(bins_count) - 1, 20, items_count);
+				bin_packing::BinPackingFitness<population_type> scalar_fitness(weights, bins_count);
+				bin_packing::BinPackingFitness<population_type> simd_fitness(weights, bins_count);
+				scalar_fitness.set_simd_level(ea::SimdLevel::scalar);
+
+				for (auto level : { ea::SimdLevel::scalar, ea::SimdLevel::avx2, ea::SimdLevel::avx512 })
+				{
+					if (level > ea::supported_simd_level())
+					{
+						continue;
+					}
+
+					simd_fitness.set_simd_level(level);
+
+					for (auto && individual : population)
+					{
+						if (simd_fitness.get_bin_weights(individual) != scalar_fitness.get_bin_weights(individual))
+						{
+							std::cout << "Bin weights - " << level_names[static_cast<size_t>(level)] << " kernel differs, genes: " << sizeof(TGene) << " B, items: " << items_count << ", bins: " << bins_count << ", max weight: " << max_weight << std::endl;
+							matches = false;
+						}
+					}
+				}
+			}
+		}
+
+		return matches;
+	}
+
+	/**
+	 * \brief Measures the fitness evaluation with genes of a given type and each supported kernel.
+	 * \tparam TGene Type of genes
+	 * \param weights Weights of items
+	 */
+	template<typename TGene>
+	void benchmark_bin_weights_genes(const std::vector<int> & weights)
+	{
+		using individual_type = ea::GenericIndividual<std::vector<TGene>, double>;
+		using population_type = std::vector<individual_type>;
+
+		const std::vector<std::string> level_names{ "scalar", "AVX2", "AVX-512" };
+		const size_t bins_count = 7;
+		const size_t pop_size = 10000;
+		const auto repetitions = 20;
+
+		bin_packing::BinPackingFitness<population_type> fitness(weights, bins_count);
+		auto population = ea::init_pop_uniform_int<population_type>(0, bins_count - 1, pop_size, weights.size());
+
+		std::cout << "Bin weights - genes: " << sizeof(TGene) << " B, bins: " << bins_count << ", population: " << pop_size << ", repetitions: " << repetitions;
+
+		for (auto level : { ea::SimdLevel::scalar, ea::SimdLevel::avx2, ea::SimdLevel::avx512 })
+		{
+			if (level > ea::supported_simd_level())
+			{
+				continue;
+			}
+
+			fitness.set_simd_level(level);
+			const auto time_start = GetTimeMs64();
+
+			for (auto i = 0; i < repetitions; ++i)
+			{
+				fitness(population);
+			}
+
+			std::cout << ", " << level_names[static_cast<size_t>(level)] << " ms: " << (GetTimeMs64() - time_start);
+		}
+
+		std::cout << std::endl;
+	}
+
+	/**
+	 * \brief Checks the SIMD kernels that compute weights of bins against the scalar loop and measures the fitness evaluation with each of them.
+	 *		  Genes of type int, uint16_t and uint8_t are checked with light items and with items so heavy that their sums need 64 bits.
+	 * \param path Path to weights of items
+	 * \return Whether all kernels computed the same weights as the scalar loop
+	 */
+	bool benchmark_bin_weights_kernels(const std::string & path)
+	{
+		auto matches = true;
+
+		// Items of 2^23 fill the 32-bit sums of lanes in the smallest blocks, heavier items are summed by the scalar loop
+		for (auto max_weight : { 10000, 1 << 23, 2000000000 })
+		{
+			matches = bin_weights_kernels_match<int>(max_weight) && matches;
+			matches = bin_weights_kernels_match<uint16_t>(max_weight) && matches;
+			matches = bin_weights_kernels_match<uint8_t>(max_weight) && matches;
+		}
+
+		const auto weights = bin_packing::load_weights(path);
+		std::cout << "Bin weights - " << path << std::endl;
+		benchmark_bin_weights_genes<int>(weights);
+		benchmark_bin_weights_genes<uint16_t>(weights);
+		benchmark_bin_weights_genes<uint8_t>(weights);
+		std::cout << "Bin weights - " << (matches ? "all kernels match the scalar loop" : "KERNELS DIFFER") << std::endl;
+
+		return matches;
+	}
+
+	/**
+	 * \brief Checks the counter-based generator against known answers and measures how fast it produces doubles compared to std::mt19937.
+	 *		  Also checks that seeded batch runs give the same results no matter how many batch threads are used.
+	 * \param path Path to weights of items
+	 * \return Whether all checks passed
+	 */
+	bool benchmark_random_streams(const std::string & path)
+	{
+		auto passed = true;
+
+		// Known answers of Philox4x32-10 from the Random123 library
+		const auto zero_block = ea::Philox4x32::block({ 0, 0, 0, 0 }, { 0, 0 });
+		const auto ones_block = ea::Philox4x32::block({ 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF }, { 0xFFFFFFFF, 0xFFFFFFFF });
+		passed = passed && zero_block == ea::Philox4x32::counter_type{ 0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8 };
+		passed = passed && ones_block == ea::Philox4x32::counter_type{ 0x408F276D, 0x41C83B0E, 0xA20BC7C6, 0x6D5451FD };
+
+		// Bulk generation must continue the stream exactly like single draws, including an odd number of words drawn before
+		ea::RandomStream single(7, ea::StreamId{ 1, 2, 3 });
+		auto bulk = single;
+		single();
+		bulk();
+		std::vector<double> uniforms(101);
+		bulk.fill_uniform(uniforms.data(), uniforms.size());
+
+		for (auto && value : uniforms)
+		{
+			passed = passed && value == single.uniform();
+		}
+
+		// Streams of individuals do not depend on how many numbers were drawn from the stream of the generation
+		passed = passed && single.split(5)() == ea::RandomStream(7, ea::StreamId{ 1, 2, 3, 5 })();
+
+		const size_t count = 10000000;
+		std::vector<double> buffer(count);
+
+		std::mt19937 mersenne_twister(1);
+		std::uniform_real_distribution<> real_distribution(0, 1);
+		auto time_start = GetTimeMs64();
+
+		for (auto && value : buffer)
+		{
+			value = real_distribution(mersenne_twister);
+		}
+
+		const auto mersenne_twister_ms = GetTimeMs64() - time_start;
+		auto checksum = buffer[count - 1];
+
+		ea::RandomStream stream(1);
+		time_start = GetTimeMs64();
+		stream.fill_uniform(buffer.data(), count);
+		const auto philox_ms = GetTimeMs64() - time_start;
+		checksum += buffer[count - 1];
+
+		std::cout << "Random streams - doubles: " << count << ", mt19937 ms: " << mersenne_twister_ms << ", Philox bulk ms: " << philox_ms << " (checksum " << checksum << ")" << std::endl;
+
+		// Seeded batches are reproducible
+		using individual_type = ea::GenericIndividual<std::vector<int>, double>;
+		using population_type = std::vector<individual_type>;
+
+		bin_packing::BinPackingSettings settings;
+		settings.bins_count = 7;
+		settings.mutation_probability = 0.6;
+		settings.crossover_probability = 0.2;
+		settings.gene_change_probability = 0.001;
+		settings.elitism = 0.05;
+		settings.output_frequency = 0;
+		settings.seed = 42;
+
+		const size_t generations = 200;
+		const size_t runs = 4;
+		const auto weights = bin_packing::load_weights(path);
+		bin_packing::BinPackingFitness<population_type> fitness(weights, settings.bins_count);
+		std::vector<std::vector<individual_type>> results;
+
+		for (size_t threads : { size_t{ 1 }, size_t{ 4 } })
+		{
+			settings.batch_threads = threads;
+			auto ea = bin_packing::create_algorithm(fitness, settings);
+
+			std::ostringstream silent;
+			const auto original_buffer = std::cout.rdbuf(silent.rdbuf());
+			results.push_back(ea.evolve_batch(generations, runs, [&]() { return ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, settings.pop_size, weights.size()); }));
+			std::cout.rdbuf(original_buffer);
+		}
+
+		auto reproducible = true;
+
+		for (size_t i = 0; i < runs; ++i)
+		{
+			reproducible = reproducible && results[0][i].fitness == results[1][i].fitness && std::equal(results[0][i].begin(), results[0][i].end(), results[1][i].begin());
+		}
+
+		passed = passed && reproducible;
+
+		std::cout << "Random streams - seeded batch with 1 and 4 threads: " << (reproducible ? "identical" : "DIFFERENT") << ", checks " << (passed ? "passed" : "FAILED") << std::endl;
+
+		return passed;
+	}
+
+	/**
+	 * \brief Checks that runs stop for the right reason after the right number of generations.
+	 * \param path Path to weights of items
+	 * \return Whether all checks passed
+	 */
+	bool benchmark_stop_conditions(const std::string & path)
+	{
+		using individual_type = ea::GenericIndividual<std::vector<int>, double>;
+		using population_type = std::vector<individual_type>;
+
+		bin_packing::BinPackingSettings settings;
+		settings.bins_count = 7;
+		settings.mutation_probability = 0.6;
+		settings.crossover_probability = 0.2;
+		settings.gene_change_probability = 0.01;
+		settings.elitism = 0.05;
+		settings.output_frequency = 0;
+		settings.seed = 42;
+
+		std::ostringstream silent;
+		const auto original_buffer = std::cout.rdbuf(silent.rdbuf());
+
+		const auto run = [&](ea::EvolutionaryAlgorithm<population_type> & ea, const std::vector<int> & weights, const size_t generations)
+		{
+			ea::rng_seed(settings.seed);
+			ea.evolve(ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, settings.pop_size, weights.size()), generations, silent);
+
+			return ea.run_result();
+		};
+
+		// The best individual of the first generation reaches a target that any assignment reaches
+		const auto weights = bin_packing::load_weights(path);
+		bin_packing::BinPackingFitness<population_type> fitness(weights, settings.bins_count);
+		auto target_ea = bin_packing::create_algorithm(fitness, settings);
+		target_ea.set_target_objective(std::numeric_limits<double>::max());
+		const auto target_result = run(target_ea, weights, 100);
+		const auto target_passed = target_result.reason == ea::StopReason::target_objective && target_result.generations == 1;
+
+		// 14 equal items fit exactly two to a bin, so the lower bound of the objective is 0 and it is reachable
+		const std::vector<int> equal_weights(14, 1000);
+		bin_packing::BinPackingFitness<population_type> equal_fitness(equal_weights, settings.bins_count);
+		auto optimum_ea = bin_packing::create_algorithm(equal_fitness, settings);
+		const size_t optimum_generations = 100000;
+		const auto optimum_result = run(optimum_ea, equal_weights, optimum_generations);
+		const auto optimum_passed = bin_packing::objective_lower_bound(equal_weights, settings.bins_count) == 0
+			&& optimum_result.reason == ea::StopReason::optimum && optimum_result.generations < optimum_generations;
+
+		// Without other conditions a run evolves exactly the given number of generations
+		auto generations_ea = bin_packing::create_algorithm(fitness, settings);
+		const size_t limited_generations = 37;
+		const auto generations_result = run(generations_ea, weights, limited_generations);
+		const auto generations_passed = generations_result.reason == ea::StopReason::generations && generations_result.generations == limited_generations;
+
+		// The first island reaches the optimum of the equal items, the other islands evolve the instance and stop with it
+		ea::IslandModel<population_type> model;
+		model.add_island(bin_packing::create_algorithm(equal_fitness, settings),
+			[&]() { return ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, settings.pop_size, equal_weights.size()); });
+
+		for (size_t island = 1; island < 3; ++island)
+		{
+			model.add_island(bin_packing::create_algorithm(fitness, settings),
+				[&]() { return ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, settings.pop_size, weights.size()); });
+		}
+
+		// Individuals of the islands have different lengths, so they cannot migrate
+		model.set_migration(0, 1, ea::MigrationTopology::ring);
+		model.set_seed(settings.seed);
+		model.evolve(optimum_generations);
+
+		auto islands_passed = true;
+
+		for (auto && result : model.island_results())
+		{
+			islands_passed = islands_passed && result.reason == ea::StopReason::optimum && result.generations < optimum_generations;
+		}
+
+		std::cout.rdbuf(original_buffer);
+
+		const auto passed = target_passed && optimum_passed && generations_passed && islands_passed;
+
+		std::cout << "Stop conditions - target objective: " << ea::stop_reason_name(target_result.reason) << " after " << target_result.generations
+			<< ", optimum: " << ea::stop_reason_name(optimum_result.reason) << " after " << optimum_result.generations
+			<< ", generations: " << ea::stop_reason_name(generations_result.reason) << " after " << generations_result.generations
+			<< ", islands:";
+
+		for (auto && result : model.island_results())
+		{
+			std::cout << " " << ea::stop_reason_name(result.reason) << " after " << result.generations;
+		}
+
+		std::cout << ", checks " << (passed ? "passed" : "FAILED") << std::endl;
+
+		return passed;
+	}
+
+	/**
+	 * \brief Checks that immigrants replace the worst individuals of an island.
+	 *		  Islands carry their populations over unchanged (elitism of the whole population and no offspring) and the second island
+	 *		  waits until the first one has migrated, so the check does not depend on the timing of the threads.
+	 * \return Whether the second island kept its best individuals and replaced the others with the best individuals of the first island
+	 */
+	bool immigrants_replace_worst()
+	{
+		using individual_type = ea::GenericIndividual<std::vector<int>, double>;
+		using population_type = std::vector<individual_type>;
+		using clock = std::chrono::steady_clock;
+
+		const size_t pop_size = 10;
+		const int immigrant_gene = 100;
+
+		// Individuals have a single gene that is also their fitness, immigrants have the fitness of at least immigrant_gene
+		const auto create_population = [=](const int first_gene) {
+			population_type population;
+
+			for (size_t i = 0; i < pop_size; ++i)
+			{
+				population.emplace_back(std::vector<int>{ first_gene + static_cast<int>(i) });
+				population.back().fitness = population.back()[0];
+			}
+
+			return population;
+		};
+
+		const auto create_algorithm = [](auto observer) {
+			ea::EvolutionaryAlgorithm<population_type> ea{};
+			ea.add_mating_selector(observer);
+			ea.set_individual_fitness([](individual_type & individual) { individual.fitness = individual[0]; });
+			ea.set_elitism(1);
+
+			return ea;
+		};
+
+		std::atomic<size_t> first_generations{ 0 };
+		size_t second_generations = 0;
+		std::vector<double> observed;
+
+		const auto first_observer = [&](const population_type &, population_type &, size_t) { ++first_generations; };
+
+		// In its third generation, the second island sees the immigrants that arrived after its first two generations
+		const auto second_observer = [&](const population_type & population, population_type &, size_t) {
+			if (++second_generations == 2)
+			{
+				const auto deadline = clock::now() + std::chrono::seconds(10);
+
+				while (first_generations.load() < 2 && clock::now() < deadline)
+				{
+					std::this_thread::yield();
+				}
+			}
+
+			observed.clear();
+
+			for (auto && individual : population)
+			{
+				observed.push_back(individual.fitness);
+			}
+		};
+
+		ea::IslandModel<population_type> model;
+		model.add_island(create_algorithm(first_observer), [&]() { return create_population(immigrant_gene); });
+		model.add_island(create_algorithm(second_observer), [&]() { return create_population(0); });
+		model.set_migration(1, 2, ea::MigrationTopology::ring);
+		model.set_seed(1);
+		model.evolve(3);
+
+		std::sort(observed.begin(), observed.end());
+		const auto immigrants = static_cast<size_t>(std::count_if(observed.begin(), observed.end(), [=](const double fitness) { return fitness >= immigrant_gene; }));
+
+		if (observed.size() != pop_size || immigrants < 2)
+		{
+			return false;
+		}
+
+		// The remaining individuals of the second island are its best ones
+		for (size_t i = 0; i < pop_size - immigrants; ++i)
+		{
+			if (observed[i] != static_cast<double>(immigrants + i))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * \brief Checks the island model: all topologies evolve bin packing islands, immigrants replace the worst individuals
+	 *		  and an exception on an island is rethrown by evolve.
+	 * \param path Path to weights of items
+	 * \return Whether all checks passed
+	 */
+	bool benchmark_island_model(const std::string & path)
+	{
+		using individual_type = ea::GenericIndividual<std::vector<int>, double>;
+		using population_type = std::vector<individual_type>;
+
+		bin_packing::BinPackingSettings settings;
+		settings.bins_count = 7;
+		settings.pop_size = 50;
+		settings.mutation_probability = 0.6;
+		settings.crossover_probability = 0.2;
+		settings.gene_change_probability = 0.01;
+		settings.elitism = 0.05;
+		settings.output_frequency = 0;
+		settings.seed = 42;
+
+		const size_t islands_count = 4;
+		const size_t generations = 40;
+		const auto weights = bin_packing::load_weights(path);
+		bin_packing::BinPackingFitness<population_type> fitness(weights, settings.bins_count);
+		const auto initializer = [&]() { return ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, settings.pop_size, weights.size()); };
+
+		std::ostringstream silent;
+		const auto original_buffer = std::cout.rdbuf(silent.rdbuf());
+
+		auto topologies_passed = true;
+
+		for (auto topology : { ea::MigrationTopology::ring, ea::MigrationTopology::fully_connected, ea::MigrationTopology::random })
+		{
+			ea::IslandModel<population_type> model;
+
+			for (size_t island = 0; island < islands_count; ++island)
+			{
+				model.add_island(bin_packing::create_algorithm(fitness, settings), initializer);
+			}
+
+			model.set_migration(5, 2, topology);
+			model.set_seed(settings.seed);
+
+			try
+			{
+				const auto best_individuals = model.evolve(generations);
+				topologies_passed = topologies_passed && best_individuals.size() == islands_count;
+
+				for (auto && result : model.island_results())
+				{
+					topologies_passed = topologies_passed && result.reason == ea::StopReason::generations && result.generations == generations;
+				}
+			}
+			catch (const std::exception &)
+			{
+				topologies_passed = false;
+			}
+		}
+
+		const auto migration_passed = immigrants_replace_worst();
+
+		// The other islands finish their generations, then the exception of the failing island is rethrown
+		ea::IslandModel<population_type> failing_model;
+		failing_model.add_island(bin_packing::create_algorithm(fitness, settings), initializer);
+		failing_model.add_island(bin_packing::create_algorithm(fitness, settings), []() -> population_type { throw std::runtime_error{ "island failed" }; });
+		failing_model.set_seed(settings.seed);
+		auto exception_passed = false;
+
+		try
+		{
+			failing_model.evolve(generations);
+		}
+		catch (const std::runtime_error & e)
+		{
+			exception_passed = std::string(e.what()) == "island failed";
+		}
+
+		std::cout.rdbuf(original_buffer);
+
+		const auto passed = topologies_passed && migration_passed && exception_passed;
+
+		std::cout << "Island model - topologies: " << (topologies_passed ? "passed" : "FAILED")
+			<< ", immigrants replace the worst: " << (migration_passed ? "passed" : "FAILED")
+			<< ", exception rethrown: " << (exception_passed ? "passed" : "FAILED") << std::endl;
+
+		return passed;
+	}
+
+	/**
+	 * \brief Checks that evolve_until does not leave its deadline behind, so that later runs evolve all their generations.
+	 * \param path Path to weights of items
+	 * \return Whether the runs after evolve_until evolved all generations and the run controls were restored
+	 */
+	bool benchmark_run_control(const std::string & path)
+	{
+		using individual_type = ea::GenericIndividual<std::vector<int>, double>;
+		using population_type = std::vector<individual_type>;
+		using clock = std::chrono::steady_clock;
+
+		bin_packing::BinPackingSettings settings;
+		settings.bins_count = 7;
+		settings.mutation_probability = 0.6;
+		settings.crossover_probability = 0.2;
+		settings.gene_change_probability = 0.01;
+		settings.elitism = 0.05;
+		settings.output_frequency = 0;
+		settings.seed = 42;
+
+		const size_t generations = 50;
+		const auto deadline = std::chrono::milliseconds(20);
+		const auto weights = bin_packing::load_weights(path);
+		bin_packing::BinPackingFitness<population_type> fitness(weights, settings.bins_count);
+		std::ostringstream silent;
+
+		const auto initial_population = [&]()
+		{
+			ea::rng_seed(settings.seed);
+
+			return ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, settings.pop_size, weights.size());
+		};
+
+		// Without a run control one is used only for the run until the deadline
+		auto ea = bin_packing::create_algorithm(fitness, settings);
+		ea.evolve_until(initial_population(), clock::now() + deadline, silent);
+		const auto until_result = ea.run_result();
+		ea.evolve(initial_population(), generations, silent);
+		const auto after_result = ea.run_result();
+		const auto without_control_passed = until_result.reason == ea::StopReason::deadline && !ea.run_control()
+			&& after_result.reason == ea::StopReason::generations && after_result.generations == generations;
+
+		// A run control that is set keeps its previous deadline
+		auto control = std::make_shared<ea::RunControl<individual_type, double>>();
+		auto controlled_ea = bin_packing::create_algorithm(fitness, settings);
+		controlled_ea.set_run_control(control);
+		controlled_ea.evolve_until(initial_population(), clock::now() + deadline, silent);
+		controlled_ea.evolve(initial_population(), generations, silent);
+		const auto controlled_result = controlled_ea.run_result();
+		const auto with_control_passed = controlled_ea.run_control() == control && control->deadline() == (clock::time_point::max)()
+			&& controlled_result.reason == ea::StopReason::generations && controlled_result.generations == generations;
+
+		const auto passed = without_control_passed && with_control_passed;
+
+		std::cout << "Run control - evolve_until: " << ea::stop_reason_name(until_result.reason) << " after " << until_result.generations
+			<< ", then evolve: " << ea::stop_reason_name(after_result.reason) << " after " << after_result.generations
+			<< ", with a set control: " << ea::stop_reason_name(controlled_result.reason) << " after " << controlled_result.generations
+			<< ", checks " << (passed ? "passed" : "FAILED") << std::endl;
+
+		return passed;
+	}
+
+	/**
+	 * \brief Checks that a run that is checkpointed and resumed ends exactly like a run that was not interrupted.
+	 * \param path Path to weights of items
+	 * \return Whether the final populations, fitness values and numbers of evaluations are equal
+	 */
+	bool benchmark_checkpoints(const std::string & path)
+	{
+		using individual_type = ea::GenericIndividual<std::vector<int>, double>;
+		using population_type = std::vector<individual_type>;
+
+		bin_packing::BinPackingSettings settings;
+		settings.bins_count = 7;
+		settings.mutation_probability = 0.6;
+		settings.crossover_probability = 0.2;
+		settings.gene_change_probability = 0.001;
+		settings.elitism = 0.05;
+		settings.output_frequency = 0;
+		settings.seed = 42;
+
+		const size_t generations = 60;
+		const size_t checkpoint_generation = 25;
+		const std::string straight_path = "benchmark_straight";
+		const std::string resumed_path = "benchmark_resumed";
+		const auto weights = bin_packing::load_weights(path);
+		bin_packing::BinPackingFitness<population_type> fitness(weights, settings.bins_count);
+
+		std::ostringstream silent;
+		const auto original_buffer = std::cout.rdbuf(silent.rdbuf());
+
+		// The final checkpoints of both runs hold their last populations
+		auto straight_ea = bin_packing::create_algorithm(fitness, settings);
+		straight_ea.set_checkpointing(straight_path, 0, std::chrono::seconds(0));
+		ea::rng_seed(settings.seed);
+		const auto straight_best = straight_ea.evolve(ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, settings.pop_size, weights.size()), generations, silent);
+		const auto straight_result = straight_ea.run_result();
+
+		auto interrupted_ea = bin_packing::create_algorithm(fitness, settings);
+		interrupted_ea.set_checkpointing(resumed_path, 0, std::chrono::seconds(0));
+		ea::rng_seed(settings.seed);
+		interrupted_ea.evolve(ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, settings.pop_size, weights.size()), checkpoint_generation, silent);
+
+		auto resumed_ea = bin_packing::create_algorithm(fitness, settings);
+		resumed_ea.set_checkpointing(resumed_path, 0, std::chrono::seconds(0));
+		const auto resumed_best = resumed_ea.resume(resumed_ea.checkpoint_path(0), generations, silent);
+		const auto resumed_result = resumed_ea.run_result();
+
+		std::cout.rdbuf(original_buffer);
+
+		ea::CheckpointState<double> straight_state;
+		ea::CheckpointState<double> resumed_state;
+		const auto straight_pop = ea::load_checkpoint<population_type>(straight_ea.checkpoint_path(0), straight_state);
+		const auto resumed_pop = ea::load_checkpoint<population_type>(resumed_ea.checkpoint_path(0), resumed_state);
+		std::remove(straight_ea.checkpoint_path(0).c_str());
+		std::remove(resumed_ea.checkpoint_path(0).c_str());
+
+		auto identical = straight_pop.size() == resumed_pop.size() && !straight_pop.empty();
+
+		for (size_t i = 0; identical && i < straight_pop.size(); ++i)
+		{
+			identical = straight_pop[i].fitness == resumed_pop[i].fitness && std::equal(straight_pop[i].begin(), straight_pop[i].end(), resumed_pop[i].begin());
+		}
+
+		identical = identical
+			&& straight_best.fitness == resumed_best.fitness && std::equal(straight_best.begin(), straight_best.end(), resumed_best.begin())
+			&& straight_result.generations == generations && resumed_result.generations == generations
+			&& straight_result.evaluations == resumed_result.evaluations && straight_state.evaluations == resumed_state.evaluations;
+
+		std::cout << "Checkpoints - " << generations << " generations straight and resumed after " << checkpoint_generation << ": "
+			<< (identical ? "identical" : "DIFFERENT") << ", evaluations: " << straight_result.evaluations << " and " << resumed_result.evaluations << std::endl;
+
+		return identical;
+	}
+
+	/**
+	 * \brief Checks that a burst of progress records bigger than the buffer of the logger drops only generation records,
+	 *		  still delivers the finished record last and reports how many records were dropped.
+	 * \return Whether the checks passed
+	 */
+	bool benchmark_progress_logger()
+	{
+		const size_t capacity = 8;
+		const size_t burst = 1000;
+		std::vector<ea::ProgressRecord> written;
+
+		ea::ProgressSink sink;
+		sink.write = [&written](const ea::ProgressRecord & record, const std::string *) {
+			// A slow sink lets the buffer fill up
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+			written.push_back(record);
+		};
+
+		uint64_t dropped;
+
+		{
+			ea::ProgressLogger logger({ sink }, capacity);
+			ea::ProgressRecord record;
+
+			for (size_t i = 0; i < burst; ++i)
+			{
+				record.generation = i + 1;
+				logger.push(record);
+			}
+
+			record.event = ea::ProgressEvent::finished;
+			logger.push(record);
+			logger.flush();
+			dropped = logger.dropped();
+		}
+
+		const auto passed = !written.empty() && dropped > 0
+			&& written.size() + dropped == burst + 1
+			&& written.back().event == ea::ProgressEvent::finished
+			&& written.back().generation == burst
+			&& written.back().dropped == dropped;
+
+		std::cout << "Progress logger - records: " << burst + 1 << ", buffer: " << capacity << ", written: " << written.size() << ", dropped: " << dropped
+			<< ", finished record " << (passed ? "delivered" : "LOST") << std::endl;
+
+		return passed;
+	}
+
+	/**
+	 * \brief Checks that loading an instance in the text format, saving it in the binary format and loading that gives the same weights,
+	 *		  and that invalid, empty and missing files are reported.
+	 * \param path Path to weights of items
+	 * \return Whether all checks passed
+	 */
+	bool benchmark_instances(const std::string & path)
+	{
+		const std::string text_path = "benchmark_instance.txt";
+		const std::string binary_path = "benchmark_instance.bin";
+		auto passed = true;
+
+		const auto weights = bin_packing::load_weights(path);
+		bin_packing::convert_weights_to_binary(path, binary_path, 4);
+		passed = passed && bin_packing::load_weights(binary_path) == weights && bin_packing::load_weights(path, 4) == weights;
+
+		// An instance of several megabytes is split into chunks that are parsed in parallel
+		std::string big_contents;
+
+		for (size_t i = 0; i < 1000000; ++i)
+		{
+			big_contents += std::to_string(weights[i % weights.size()]) + (i % 3 == 0 ? "\r\n" : "\n");
+		}
+
+		if (const auto file = std::fopen(text_path.c_str(), "wb"))
+		{
+			std::fwrite(big_contents.data(), 1, big_contents.size(), file);
+			std::fclose(file);
+		}
+
+		const auto big_weights = bin_packing::load_weights(text_path);
+		bin_packing::convert_weights_to_binary(text_path, binary_path, 4);
+		passed = passed && big_weights.size() == 1000000 && bin_packing::load_weights(text_path, 4) == big_weights && bin_packing::load_weights(binary_path) == big_weights;
+
+		// Writes a text instance and checks that loading it fails with a message that contains a given text
+		const auto fails_with = [&](const std::string & contents, const std::string & message)
+		{
+			if (const auto file = std::fopen(text_path.c_str(), "wb"))
+			{
+				std::fwrite(contents.data(), 1, contents.size(), file);
+				std::fclose(file);
+			}
+
+			try
+			{
+				bin_packing::load_weights(text_path);
+			}
+			catch (const std::runtime_error & e)
+			{
+				return std::string(e.what()).find(message) != std::string::npos;
+			}
+
+			return false;
+		};
+
+		passed = fails_with("10\n 20 \r\n\nabc\n30\n", "line 4 of") && passed;
+		passed = fails_with("10\n20x\n", "line 2 of") && passed;
+		passed = fails_with("10\n2147483648\n", "line 2 of") && passed;
+		passed = fails_with("-2147483649\n", "line 1 of") && passed;
+		passed = fails_with("", "No weights") && passed;
+		passed = fails_with(" \n\t\r\n\n", "No weights") && passed;
+
+		try
+		{
+			bin_packing::load_weights("benchmark_missing_instance.txt");
+			passed = false;
+		}
+		catch (const std::runtime_error & e)
+		{
+			passed = std::string(e.what()).find("Cannot open") != std::string::npos && passed;
+		}
+
+		// The binary format is recognized by its header, not by the name of the file
+		bin_packing::save_weights_binary(text_path, { 1, -2, 2147483647 });
+		passed = passed && bin_packing::load_weights(text_path) == std::vector<int>{ 1, -2, 2147483647 };
+
+		std::remove(text_path.c_str());
+		std::remove(binary_path.c_str());
+
+		std::cout << "Instances - items: " << weights.size() << ", binary round trip and errors " << (passed ? "passed" : "FAILED") << std::endl;
+
+		return passed;
+	}
+}
+
+int main(int argc, char * argv[])
+{
+	const std::string harder_path = argc > 1 ? argv[1] : "../EvolutionaryAlgorithms/packingInput-harder.txt";
+
+	benchmark_fitness_threads(harder_path);
+	benchmark_batch_threads(harder_path);
+	benchmark_packed_bits();
+	const auto gene_sampling_pass = benchmark_gene_sampling();
+	benchmark_crossovers<std::vector<ea::GenericIndividual<std::vector<int>, double>>>("vector<int>", 10000, 2000);
+	benchmark_crossovers<std::vector<ea::GenericIndividual<std::array<bool, 4096>, int>>>("array<bool, 4096>", 4096, 2000);
+	benchmark_roulette_selection();
+	benchmark_shared_genomes(harder_path);
+	benchmark_contiguous_population(harder_path);
+	benchmark_static_pipeline(harder_path);
+	const auto local_search_pass = benchmark_local_search(harder_path);
+	const auto kernels_match = benchmark_bin_weights_kernels(harder_path);
+	const auto random_streams_pass = benchmark_random_streams(harder_path);
+	const auto allocation_free = benchmark_allocations(harder_path);
+	const auto stop_conditions_pass = benchmark_stop_conditions(harder_path);
+	const auto island_model_pass = benchmark_island_model(harder_path);
+	const auto run_control_pass = benchmark_run_control(harder_path);
+	const auto checkpoints_pass = benchmark_checkpoints(harder_path);
+	const auto progress_logger_pass = benchmark_progress_logger();
+	const auto instances_pass = benchmark_instances(harder_path);
+
+	return gene_sampling_pass && kernels_match && random_streams_pass && allocation_free && stop_conditions_pass && island_model_pass && run_control_pass && checkpoints_pass && progress_logger_pass && instances_pass && local_search_pass ? 0 : 1;
+}
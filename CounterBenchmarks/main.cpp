@@ -0,0 +1,166 @@
+// The whole program is built with the event counters, see Utils/Instrumentation.h
+#ifndef EA_INSTRUMENTATION
+#define EA_INSTRUMENTATION
+#endif
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "BinPacking/BinPacking.h"
+#include "SGA/SGA.h"
+#include "Utils/Instrumentation.h"
+
+EA_DEFINE_COUNTING_OPERATOR_NEW()
+
+namespace
+{
+	/**
+	 * \brief Prints the counters of every generation as CSV and checks that every generation counted evaluations, selections and random numbers.
+	 * \tparam TPopulation
+	 * \param name Name of the problem
+	 * \param ea
+	 * \param population The initial population
+	 * \param generations
+	 * \return Whether all generations counted the events
+	 */
+	template<typename TPopulation>
+	bool count_generations(const std::string & name, ea::EvolutionaryAlgorithm<TPopulation> & ea, TPopulation population, const size_t generations)
+	{
+		std::vector<ea::CounterSnapshot> snapshots;
+		snapshots.reserve(generations);
+		ea.set_counter_sink([&snapshots](const ea::CounterSnapshot & snapshot) { snapshots.push_back(snapshot); });
+
+		TPopulation next_pop{};
+
+		for (size_t i = 0; i < generations; ++i)
+		{
+			ea.evolve(population, next_pop);
+			std::swap(population, next_pop);
+		}
+
+		ea.set_counter_sink(nullptr);
+
+		auto counted = snapshots.size() == generations;
+
+		for (auto && snapshot : snapshots)
+		{
+			std::cout << name << "," << snapshot.generation;
+
+			for (auto value : snapshot.generation_values)
+			{
+				std::cout << "," << value;
+			}
+
+			std::cout << std::endl;
+
+			counted = counted
+				&& snapshot.generation_values[static_cast<size_t>(ea::Counter::evaluations)] > 0
+				&& snapshot.generation_values[static_cast<size_t>(ea::Counter::selector_draws)] > 0
+				&& snapshot.generation_values[static_cast<size_t>(ea::Counter::rng_calls)] > 0;
+		}
+
+		return counted;
+	}
+
+	/**
+	 * \brief Counts the events of the simple genetic algorithm configured as in solve_sga.
+	 */
+	bool count_sga(const size_t pop_size, const size_t genome_length, const size_t threads, const size_t generations)
+	{
+		using individual_type = ea::PackedBitIndividual<int>;
+		using population_type = std::vector<individual_type>;
+
+		sga::SGASettings settings;
+		ea::EvolutionaryAlgorithm<population_type> ea{};
+
+		ea.add_operator(ea::BitFlipMutation<population_type>{settings.bit_mutation_probability, settings.gene_sampling});
+		ea.add_operator(ea::OnePtXOver<population_type>{settings.crossover_probability});
+		ea.add_mating_selector(ea::RouletteWheelSelector<population_type>{});
+		ea.set_individual_fitness(sga::OneMaxFitness<population_type>{});
+		ea.set_fitness_threads(threads);
+		ea.set_elitism(0.01);
+
+		ea::rng_seed(1);
+		auto population = ea::init_pop_uniform_bits<population_type>(pop_size, genome_length);
+		ea.evaluate(population);
+
+		return count_generations("sga", ea, population, generations);
+	}
+
+	/**
+	 * \brief Counts the events of the bin packing algorithm configured as in main.
+	 */
+	bool count_bin_packing(const std::vector<int> & weights, const size_t pop_size, const size_t threads, const size_t generations)
+	{
+		using individual_type = bin_packing::BinPackingIndividual<std::vector<int>, double>;
+		using population_type = ea::RecyclingPopulation<individual_type>;
+
+		bin_packing::BinPackingSettings settings;
+		settings.mutation_probability = 0.6;
+		settings.crossover_probability = 0.2;
+		settings.gene_change_probability = 0.001;
+		settings.gene_sampling = ea::GeneSampling::skip;
+		settings.bins_count = 7;
+		settings.elitism = 0.05;
+		settings.fitness_threads = threads;
+
+		bin_packing::BinPackingFitness<population_type> fitness(weights, settings.bins_count);
+		auto ea = bin_packing::create_algorithm(fitness, settings);
+
+		ea::rng_seed(1);
+		auto population = ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, pop_size, weights.size());
+		ea.evaluate(population);
+
+		return count_generations("bin_packing", ea, population, generations);
+	}
+}
+
+/**
+ * \brief Prints the events counted in every generation of both shipped problems as CSV.
+ *		  Usage: CounterBenchmarks [generations] [path to weights of items]
+ *		  Fails if a generation did not count evaluations, selections or random numbers.
+ */
+int main(int argc, char * argv[])
+{
+	const size_t generations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20;
+	const std::string path = argc > 2 ? argv[2] : "../EvolutionaryAlgorithms/packingInput-harder.txt";
+
+	if (generations == 0)
+	{
+		std::cerr << "Usage: CounterBenchmarks [generations] [path to weights of items]" << std::endl;
+		return 1;
+	}
+
+	std::vector<int> weights;
+
+	try
+	{
+		weights = bin_packing::load_weights(path, 0);
+	}
+	catch (const std::exception & e)
+	{
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+	std::cout << "problem,generation";
+
+	for (size_t i = 0; i < ea::counters_count; ++i)
+	{
+		std::cout << "," << ea::counter_name(static_cast<ea::Counter>(i));
+	}
+
+	std::cout << std::endl;
+
+	// Two fitness threads make the counters of several threads be summed
+	auto counted = count_sga(1000, 1000, 2, generations);
+	counted = count_bin_packing(weights, 1000, 2, generations) && counted;
+
+	if (!counted)
+	{
+		std::cerr << "Some generations did not count events" << std::endl;
+	}
+
+	return counted ? 0 : 1;
+}
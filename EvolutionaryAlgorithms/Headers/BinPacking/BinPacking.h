@@ -1,14 +1,21 @@
 ﻿#ifndef BINPACKING_H
 #define BINPACKING_H
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <string>
-#include <fstream>
 #include <vector>
 #include "EvolutionaryAlgorithm.h"
+#include "IslandModel.h"
 #include "Operators/IntegerMutation.h"
 #include "Operators/OnePtXOver.h"
 #include "BinPacking/BinPackingFitness.h"
+#include "BinPacking/BinPackingIndividual.h"
+#include "BinPacking/Instance.h"
+#include "BinPacking/LocalSearch.h"
 #include "Individuals/GenericIndividual.h"
+#include "Populations/RecyclingPopulation.h"
 #include "Selectors/TournamentSelector.h"
 #include "Utils/Initializer.h"
 #include "Utils/Settings.h"
@@ -20,36 +27,28 @@ namespace bin_packing
 		double mutation_probability = 0.1; // Probability of mutation
 		double gene_change_probability = 0.1; // Probability of changing a gene
 		double crossover_probability = 0.1; // Probability of crossover
+		size_t tournament_size = 2; // Number of contestants in each tournament of selectors
+		double tournament_pressure = 0.8; // Probability that the best contestant of a tournament wins
+		ea::GeneSampling gene_sampling = ea::GeneSampling::per_gene; // How are mutated genes chosen
 		size_t bins_count = 5; // Number of bins
+		size_t islands_count = 4; // Number of islands in the island model
+		size_t migration_interval = 50; // Every how many generations do islands exchange individuals
+		size_t migrants_count = 2; // How many individuals are sent to each target island
+		ea::MigrationTopology migration_topology = ea::MigrationTopology::ring; // Which islands exchange individuals
+		double local_search_probability = 0; // Probability that an offspring is improved by the local search, 0 disables it
+		size_t local_search_steps = 50; // Maximum number of steps of the local search of an individual, each applies at most one move
+		size_t local_search_candidates = 16; // Number of moves sampled in each step of the local search
 	};
 
-	/**
-	 * \brief Loads the weight of items from a given file.
-	 * \param path 
-	 * \return 
-	 */
-	inline std::vector<int> load_weights(const std::string & path)
-	{
-		std::ifstream myfile(path);
-		std::string line;
-		std::vector<int> bins;
-
-		while (getline(myfile, line))
-		{
-			bins.push_back(std::stoi(line));
-		}
-
-		return bins;
-	}
-
 	/**
 	 * \brief Pretty prints given weights.
 	 * \param weights 
 	 * \return 
 	 */
-	inline std::string weights_to_string(const std::vector<int> & weights)
+	inline std::string weights_to_string(const std::vector<int64_t> & weights)
 	{
 		std::string s = "<";
+		s.reserve(weights.size() * 8 + 2);
 
 		for (size_t i = 0; i < weights.size(); ++i)
 		{
@@ -71,10 +70,10 @@ namespace bin_packing
 	 * \param weights 
 	 * \return 
 	 */
-	inline double compute_objective(const std::vector<int> & weights)
+	inline double compute_objective(const std::vector<int64_t> & weights)
 	{
-		auto min = (std::numeric_limits<int>::max)();
-		auto max = (std::numeric_limits<int>::min)();
+		auto min = (std::numeric_limits<int64_t>::max)();
+		auto max = (std::numeric_limits<int64_t>::min)();
 
 		for (auto && bin_weight : weights)
 		{
@@ -89,40 +88,198 @@ namespace bin_packing
 			}
 		}
 
-		return max - min;
+		return static_cast<double>(max - min);
 	}
 
 	/**
-	 * \brief Tries to solve the bin packing problem.
-	 * \param path Path to weights of items
+	 * \brief Computes a lower bound of the objective of any assignment of items to bins.
+	 *		  The bins cannot be perfectly balanced if the total weight is not divisible by the number of bins.
+	 *		  The bin with the heaviest item weighs at least that item, while the lightest bin weighs at most
+	 *		  the average of the remaining bins without that item.
+	 * \param weights Weights of individual items
+	 * \param bins_count Number of bins
+	 * \return
+	 */
+	inline double objective_lower_bound(const std::vector<int> & weights, const size_t bins_count)
+	{
+		if (weights.empty() || bins_count < 2)
+		{
+			return 0;
+		}
+
+		long long sum = 0;
+		long long max = 0;
+
+		for (auto && weight : weights)
+		{
+			sum += weight;
+			max = (std::max)(max, static_cast<long long>(weight));
+		}
+
+		const auto bins = static_cast<long long>(bins_count);
+		const long long divisibility_bound = sum % bins != 0 ? 1 : 0;
+		const auto heaviest_item_bound = max - (sum - max) / (bins - 1);
+
+		return static_cast<double>((std::max)(divisibility_bound, heaviest_item_bound));
+	}
+
+	/**
+	 * \brief Creates the evolutionary algorithm for the bin packing problem.
+	 * \tparam TPopulation
+	 * \param fitness Fitness function. Must outlive the algorithm.
 	 * \param settings
+	 * \return
 	 */
-	inline void solve_bin_packing(const std::string & path, const BinPackingSettings & settings)
+	template<typename TPopulation>
+	ea::EvolutionaryAlgorithm<TPopulation> create_algorithm(BinPackingFitness<TPopulation> & fitness, const BinPackingSettings & settings)
 	{
-		using individual_type = ea::GenericIndividual<std::vector<int>, double>;
-		using population_type = std::vector<individual_type>;
+		using individual_type = typename TPopulation::value_type;
 
-		if (settings.bins_count < 2)
-			throw std::invalid_argument{ "The number of bins should be at least two." };
+		ea::EvolutionaryAlgorithm<TPopulation> ea;
 
-		const auto weights = load_weights(path);
-		ea::EvolutionaryAlgorithm<population_type> ea;
+		// The local search shares the fitness pool
+		ea.set_fitness_threads(settings.fitness_threads);
+		ea.add_operator(ea::OnePtXOver<TPopulation>(settings.crossover_probability));
+		ea.add_operator(ea::IntegerMutation<TPopulation>(0, settings.bins_count - 1, settings.mutation_probability, settings.gene_change_probability, settings.gene_sampling));
 
-		BinPackingFitness<population_type> fitness(weights, settings.bins_count);
+		if (settings.local_search_probability > 0)
+		{
+			ea.add_operator(BinPackingLocalSearch<TPopulation>(fitness, settings.local_search_probability, settings.local_search_steps, settings.local_search_candidates, ea.fitness_pool()));
+		}
 
-		ea.add_operator(ea::OnePtXOver<population_type>(settings.crossover_probability));
-		ea.add_operator(ea::IntegerMutation<population_type>(0, settings.bins_count - 1, settings.mutation_probability, settings.gene_change_probability));
-		ea.add_mating_selector(ea::TournamentSelector<population_type>());
-		ea.add_natural_selector(ea::TournamentSelector<population_type>());
+		ea.add_mating_selector(ea::TournamentSelector<TPopulation>(settings.tournament_size, settings.tournament_pressure));
+		ea.add_natural_selector(ea::TournamentSelector<TPopulation>(settings.tournament_size, settings.tournament_pressure));
 		ea.set_elitism(settings.elitism);
 		ea.set_fitness(fitness);
+		ea.set_individual_fitness(fitness);
+		ea.set_batch_threads(settings.batch_threads);
+
+		if (settings.seed != 0)
+		{
+			ea.set_seed(settings.seed);
+		}
 
 		ea.set_objective([&](auto & ind) { return compute_objective(fitness.get_bin_weights(ind)); });
 		ea.set_individual_to_string([&](individual_type & ind) { return weights_to_string(fitness.get_bin_weights(ind)); });
 		ea.set_output_frequency(settings.output_frequency);
 
+		// A run cannot do better than the lower bound, so it stops as soon as it finds a provably optimal assignment
+		ea.set_objective_bound(objective_lower_bound(fitness.weights(), settings.bins_count));
+		ea.set_stagnation_limit(settings.stagnation_generations);
+		ea.set_max_evaluations(settings.max_evaluations);
+		ea.set_time_limit(std::chrono::milliseconds(settings.time_limit_ms));
+
+		if (!settings.checkpoint_path.empty())
+		{
+			ea.set_checkpointing(settings.checkpoint_path, settings.checkpoint_generations, std::chrono::seconds(settings.checkpoint_interval_s));
+		}
+
+		return ea;
+	}
+
+	/**
+	 * \brief Calls a given function with a value of the narrowest type of genes that can hold indices of all bins.
+	 *		  Narrow genes make copies, crossovers and scans of individuals cheaper.
+	 * \param bins_count Number of bins
+	 * \param function Generic function that is called with a value of uint8_t, uint16_t or int
+	 */
+	template<typename TFunction>
+	void visit_gene_type(const size_t bins_count, TFunction && function)
+	{
+		if (bins_count <= 256)
+		{
+			function(uint8_t{});
+		}
+		else if (bins_count <= 65536)
+		{
+			function(uint16_t{});
+		}
+		else
+		{
+			function(int{});
+		}
+	}
+
+	/**
+	 * \brief Tries to solve the bin packing problem with genes of a given type.
+	 * \tparam TGene Type of genes, must hold indices of all bins
+	 * \param weights Weights of items
+	 * \param settings
+	 */
+	template<typename TGene>
+	void solve_bin_packing(const std::vector<int> & weights, const BinPackingSettings & settings)
+	{
+		using individual_type = BinPackingIndividual<std::vector<TGene>, double>;
+		using population_type = ea::RecyclingPopulation<individual_type>;
+
+		BinPackingFitness<population_type> fitness(weights, settings.bins_count);
+		auto ea = create_algorithm(fitness, settings);
+
 		ea.evolve_batch(settings.generations, settings.number_of_runs, [&]() { return ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, settings.pop_size, weights.size()); });
 	}
+
+	/**
+	 * \brief Tries to solve the bin packing problem. Genes are as narrow as the number of bins allows (see visit_gene_type).
+	 * \param path Path to weights of items
+	 * \param settings
+	 */
+	inline void solve_bin_packing(const std::string & path, const BinPackingSettings & settings)
+	{
+		if (settings.bins_count < 2)
+			throw std::invalid_argument{ "The number of bins should be at least two." };
+
+		const auto weights = load_weights(path);
+		visit_gene_type(settings.bins_count, [&](auto gene) { solve_bin_packing<decltype(gene)>(weights, settings); });
+	}
+
+	/**
+	 * \brief Tries to solve the bin packing problem with the island model and genes of a given type.
+	 * \tparam TGene Type of genes, must hold indices of all bins
+	 * \param weights Weights of items
+	 * \param settings
+	 */
+	template<typename TGene>
+	void solve_bin_packing_islands(const std::vector<int> & weights, const BinPackingSettings & settings)
+	{
+		using individual_type = BinPackingIndividual<std::vector<TGene>, double>;
+		using population_type = ea::RecyclingPopulation<individual_type>;
+
+		BinPackingFitness<population_type> fitness(weights, settings.bins_count);
+		ea::IslandModel<population_type> model;
+
+		for (size_t i = 0; i < settings.islands_count; ++i)
+		{
+			model.add_island(create_algorithm(fitness, settings), [&]() { return ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, settings.pop_size, weights.size()); });
+		}
+
+		model.set_migration(settings.migration_interval, settings.migrants_count, settings.migration_topology);
+
+		if (settings.seed != 0)
+		{
+			model.set_seed(settings.seed);
+		}
+
+		for (size_t run = 0; run < settings.number_of_runs; ++run)
+		{
+			std::cout << "<< Run " << run << " >>" << std::endl;
+			model.evolve(settings.generations, run);
+		}
+	}
+
+	/**
+	 * \brief Tries to solve the bin packing problem with the island model.
+	 *		  Every island evolves its own population of pop_size individuals on its own thread.
+	 * \param path Path to weights of items
+	 * \param settings
+	 */
+	inline void solve_bin_packing_islands(const std::string & path, const BinPackingSettings & settings)
+	{
+		if (settings.bins_count < 2)
+			throw std::invalid_argument{ "The number of bins should be at least two." };
+
+		const auto weights = load_weights(path);
+		visit_gene_type(settings.bins_count, [&](auto gene) { solve_bin_packing_islands<decltype(gene)>(weights, settings); });
+	}
 }
 
 #endif // BINPACKING_H
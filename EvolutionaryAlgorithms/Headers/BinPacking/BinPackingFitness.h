@@ -1,13 +1,22 @@
 ﻿#ifndef BINPACKINGFITNESS_H
 #define BINPACKINGFITNESS_H
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <limits>   
+#include <stdexcept>
+#include <type_traits>
+#include "BinPacking/BinPackingIndividual.h"
+#include "BinPacking/BinWeightsKernel.h"
+#include "Individuals/ContiguousIndividual.h"
+#include "Utils/CpuFeatures.h"
 
 namespace bin_packing
 {
 	/**
 	 * \brief Fitness function for the bin packing problem. 
 	 *		  The value is computed to be 1 / ((the difference between the biggest and the smallest bin) + 1).
+	 *		  Weights of bins are summed in 64-bit integers, so any number of items fits.
 	 * \tparam TPopulation 
 	 */
 	template<typename TPopulation>
@@ -16,6 +25,8 @@ namespace bin_packing
 		using individual_type = typename TPopulation::value_type;
 		const std::vector<int> & weights_;
 		size_t bins_count_;
+		size_t block_items_;
+		ea::SimdLevel simd_level_ = ea::supported_simd_level();
 
 	public:
 		/**
@@ -23,11 +34,42 @@ namespace bin_packing
 		 * \param weights Weights of individual items.
 		 * \param bins_count Number of bins.
 		 */
-		explicit BinPackingFitness(const std::vector<int> & weights, const size_t bins_count) : weights_(weights), bins_count_(bins_count)
+		explicit BinPackingFitness(const std::vector<int> & weights, const size_t bins_count)
+			: weights_(weights), bins_count_(bins_count), block_items_(max_block_items(weights.data(), weights.size()))
 		{
 			/* empty */
 		}
 
+		/**
+		 * \brief Weights of individual items.
+		 * \return
+		 */
+		const std::vector<int> & weights() const
+		{
+			return weights_;
+		}
+
+		/**
+		 * \brief Number of bins.
+		 * \return
+		 */
+		size_t bins_count() const
+		{
+			return bins_count_;
+		}
+
+		/**
+		 * \brief Sets the instruction set that is used to compute weights of bins. The best supported one is used by default.
+		 * \param level
+		 */
+		void set_simd_level(const ea::SimdLevel level)
+		{
+			if (level > ea::supported_simd_level())
+				throw std::invalid_argument("The instruction set is not supported by the CPU");
+
+			simd_level_ = level;
+		}
+
 		/**
 		 * \brief Sets the fitness of all individuals.
 		 * \param population 
@@ -42,14 +84,29 @@ namespace bin_packing
 
 		/**
 		 * \brief Sets the fitness of a given individual.
+		 * \remarks Individuals that track weights of their bins (BinPackingIndividual) start tracking them
+		 *		    on their first evaluation and are then evaluated in O(bins).
 		 * \param individual 
 		 */
 		void operator()(individual_type & individual)
 		{
-			auto min = (std::numeric_limits<int>::max)();
-			auto max = (std::numeric_limits<int>::min)();
+			track_bin_weights(individual);
+			const auto tracked_weights = tracked_bin_weights(individual);
+
+			// Reuse the buffer of the current thread so that the evaluation does not allocate
+			thread_local std::vector<int64_t> scanned_weights;
+
+			if (tracked_weights == nullptr)
+			{
+				scan_bin_weights(individual, scanned_weights);
+			}
+
+			const auto & bin_weights = tracked_weights != nullptr ? *tracked_weights : scanned_weights;
 
-			for (auto && bin_weight : get_bin_weights(individual))
+			auto min = (std::numeric_limits<int64_t>::max)();
+			auto max = (std::numeric_limits<int64_t>::min)();
+
+			for (auto && bin_weight : bin_weights)
 			{
 				if (bin_weight > max)
 				{
@@ -62,7 +119,7 @@ namespace bin_packing
 				}
 			}
 
-			const auto fitness = 1.0 / ((max - min) + 1);
+			const auto fitness = 1.0 / static_cast<double>((max - min) + 1);
 			individual.fitness = fitness;
 		}
 
@@ -71,16 +128,140 @@ namespace bin_packing
 		 * \param individual 
 		 * \return 
 		 */
-		std::vector<int> get_bin_weights(individual_type & individual)
+		std::vector<int64_t> get_bin_weights(const individual_type & individual) const
+		{
+			std::vector<int64_t> weights;
+			get_bin_weights(individual, weights);
+
+			return weights;
+		}
+
+		/**
+		 * \brief Computes weights of individual bins into a given vector.
+		 * \param individual 
+		 * \param weights Vector that is overwritten with the weights. Its storage is reused.
+		 */
+		void get_bin_weights(const individual_type & individual, std::vector<int64_t> & weights) const
+		{
+			const auto tracked_weights = tracked_bin_weights(individual);
+
+			if (tracked_weights != nullptr)
+			{
+				weights.assign(tracked_weights->begin(), tracked_weights->end());
+			}
+			else
+			{
+				scan_bin_weights(individual, weights);
+			}
+		}
+
+	private:
+		/**
+		 * \brief Computes weights of bins by scanning all items.
+		 *		  Genes that are stored contiguously are scanned with the SIMD kernel.
+		 * \param individual 
+		 * \param weights 
+		 */
+		void scan_bin_weights(const individual_type & individual, std::vector<int64_t> & weights) const
+		{
+			scan_bin_weights(contiguous_genes(individual), individual, weights);
+		}
+
+		/**
+		 * \brief Computes weights of bins from contiguous genes with the SIMD kernel.
+		 */
+		template<typename TGene>
+		void scan_bin_weights(const TGene * genes, const individual_type & individual, std::vector<int64_t> & weights) const
+		{
+			weights.resize(bins_count_);
+
+			if (genes != nullptr)
+			{
+				bin_packing::scan_bin_weights(genes, weights_.data(), individual.size(), bins_count_, weights.data(), simd_level_, block_items_);
+			}
+			else
+			{
+				std::fill(weights.begin(), weights.end(), 0);
+			}
+		}
+
+		/**
+		 * \brief Computes weights of bins of individuals without contiguous genes.
+		 */
+		void scan_bin_weights(std::nullptr_t, const individual_type & individual, std::vector<int64_t> & weights) const
 		{
-			std::vector<int> weights(bins_count_, 0);
+			weights.assign(bins_count_, 0);
 
 			for (size_t i = 0; i < individual.size(); ++i)
 			{
 				weights[individual[i]] += weights_[i];
 			}
+		}
 
-			return weights;
+		/**
+		 * \brief Genes of other individuals are not known to be stored contiguously.
+		 */
+		template<typename TIndividual>
+		static std::nullptr_t contiguous_genes(const TIndividual &)
+		{
+			return nullptr;
+		}
+
+		/**
+		 * \brief Gets the genes stored in a vector.
+		 */
+		template<typename TGene, typename TFitness>
+		static typename std::enable_if<is_kernel_gene<TGene>::value, const TGene *>::type contiguous_genes(const ea::GenericIndividual<std::vector<TGene>, TFitness> & individual)
+		{
+			return individual.size() != 0 ? &individual[0] : nullptr;
+		}
+
+		/**
+		 * \brief Gets the genes stored in a row of a contiguous population.
+		 */
+		template<typename TGene, typename TFitness>
+		static typename std::enable_if<is_kernel_gene<TGene>::value, const TGene *>::type contiguous_genes(const ea::ContiguousIndividual<TGene, TFitness> & individual)
+		{
+			return individual.begin();
+		}
+
+		/**
+		 * \brief Individuals that cannot track weights of their bins are left as they are.
+		 */
+		template<typename TIndividual>
+		void track_bin_weights(TIndividual &) const
+		{
+			/* empty */
+		}
+
+		/**
+		 * \brief Starts tracking weights of bins if the individual does not track them yet.
+		 */
+		template<typename TContainer, typename TFitness>
+		void track_bin_weights(BinPackingIndividual<TContainer, TFitness> & individual) const
+		{
+			if (!individual.has_bin_weights())
+			{
+				individual.track_bin_weights(weights_, bins_count_);
+			}
+		}
+
+		/**
+		 * \brief Individuals that cannot track weights of their bins have no tracked weights.
+		 */
+		template<typename TIndividual>
+		static const std::vector<int64_t> * tracked_bin_weights(const TIndividual &)
+		{
+			return nullptr;
+		}
+
+		/**
+		 * \brief Gets tracked weights of bins if there are any.
+		 */
+		template<typename TContainer, typename TFitness>
+		static const std::vector<int64_t> * tracked_bin_weights(const BinPackingIndividual<TContainer, TFitness> & individual)
+		{
+			return individual.has_bin_weights() ? &individual.bin_weights() : nullptr;
 		}
 	};
 
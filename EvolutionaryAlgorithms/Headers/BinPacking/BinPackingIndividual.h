@@ -0,0 +1,175 @@
+#ifndef BINPACKINGINDIVIDUAL_H
+#define BINPACKINGINDIVIDUAL_H
+#include <cstdint>
+#include <vector>
+#include "Individuals/GenericIndividual.h"
+
+namespace bin_packing
+{
+	/**
+	 * \brief Individual for the bin packing problem that keeps track of the total weight of each bin.
+	 *		  The i-th element is the bin of the i-th item.
+	 * \tparam TContainer Type of the used container
+	 * \tparam TFitness Type of the fitness value
+	 * \remarks Bin weights are computed once with track_bin_weights and then updated by set, swap_range and swap_masked,
+	 *		    so a changed gene costs two additions instead of a scan of all items. They are 64-bit, so they cannot overflow
+	 *		    even if the genes are narrow (e.g. std::vector<uint8_t> for up to 256 bins).
+	 *		    Elements can be changed only with set, swap_range and swap_masked, direct access is read-only.
+	 */
+	template<typename TContainer, typename TFitness>
+	class BinPackingIndividual : public ea::GenericIndividual<TContainer, TFitness>
+	{
+		using base_type = ea::GenericIndividual<TContainer, TFitness>;
+
+		const std::vector<int> * item_weights_ = nullptr;
+		std::vector<int64_t> bin_weights_;
+
+	public:
+		using element_type = typename base_type::element_type;
+
+		using base_type::base_type;
+
+		/**
+		 * \brief Operatror[] on the container. Use set to change elements.
+		 * \param index
+		 * \return
+		 */
+		const element_type & operator[](const size_t index) const
+		{
+			return base_type::operator[](index);
+		}
+
+		/**
+		 * \brief Gets the begin iterator of the container
+		 * \return
+		 */
+		typename TContainer::const_iterator begin() const
+		{
+			return base_type::begin();
+		}
+
+		/**
+		 * \brief Gets the end iterator of the container.
+		 * \return
+		 */
+		typename TContainer::const_iterator end() const
+		{
+			return base_type::end();
+		}
+
+		/**
+		 * \brief Computes weights of bins and keeps them up to date from now on.
+		 * \param item_weights Weights of individual items. Must outlive the individual and all its copies.
+		 * \param bins_count Number of bins.
+		 */
+		void track_bin_weights(const std::vector<int> & item_weights, const size_t bins_count)
+		{
+			item_weights_ = &item_weights;
+			bin_weights_.assign(bins_count, 0);
+
+			for (size_t i = 0; i < this->size(); ++i)
+			{
+				bin_weights_[(*this)[i]] += item_weights[i];
+			}
+		}
+
+		/**
+		 * \brief Whether weights of bins are tracked.
+		 * \return
+		 */
+		bool has_bin_weights() const
+		{
+			return item_weights_ != nullptr;
+		}
+
+		/**
+		 * \brief Tracked weights of bins. Valid only if has_bin_weights returns true.
+		 * \return
+		 */
+		const std::vector<int64_t> & bin_weights() const
+		{
+			return bin_weights_;
+		}
+
+		/**
+		 * \brief Moves an item to a given bin.
+		 * \param index
+		 * \param value
+		 */
+		void set(const size_t index, const element_type & value)
+		{
+			if (has_bin_weights())
+			{
+				bin_weights_[(*this)[index]] -= (*item_weights_)[index];
+				bin_weights_[value] += (*item_weights_)[index];
+			}
+
+			base_type::set(index, value);
+		}
+
+		/**
+		 * \brief Swaps bins of items in the range [begin, end) with another individual. Only the swapped range is visited.
+		 * \param other
+		 * \param begin
+		 * \param end
+		 */
+		void swap_range(BinPackingIndividual & other, const size_t begin, const size_t end)
+		{
+			if (has_bin_weights() && other.has_bin_weights())
+			{
+				for (auto i = begin; i < end; ++i)
+				{
+					const auto bin = (*this)[i];
+					const auto other_bin = other[i];
+
+					if (bin != other_bin)
+					{
+						const auto weight = (*item_weights_)[i];
+						bin_weights_[bin] -= weight;
+						bin_weights_[other_bin] += weight;
+						other.bin_weights_[other_bin] -= weight;
+						other.bin_weights_[bin] += weight;
+					}
+				}
+			}
+			else
+			{
+				item_weights_ = nullptr;
+				other.item_weights_ = nullptr;
+			}
+
+			base_type::swap_range(other, begin, end);
+		}
+
+		/**
+		 * \brief Swaps bins of items whose bits in a given mask are set with another individual.
+		 * \param other
+		 * \param mask Bit i of the word (i / 64) belongs to the item i.
+		 */
+		void swap_masked(BinPackingIndividual & other, const uint64_t * mask)
+		{
+			if (has_bin_weights() && other.has_bin_weights())
+			{
+				ea::for_each_set_bit(this->size(), mask, [&](const size_t i)
+				{
+					const auto bin = (*this)[i];
+					const auto other_bin = other[i];
+					const auto weight = (*item_weights_)[i];
+
+					bin_weights_[bin] -= weight;
+					bin_weights_[other_bin] += weight;
+					other.bin_weights_[other_bin] -= weight;
+					other.bin_weights_[bin] += weight;
+				});
+			}
+			else
+			{
+				item_weights_ = nullptr;
+				other.item_weights_ = nullptr;
+			}
+
+			base_type::swap_masked(other, mask);
+		}
+	};
+}
+#endif // BINPACKINGINDIVIDUAL_H
@@ -0,0 +1,355 @@
+#ifndef BINWEIGHTSKERNEL_H
+#define BINWEIGHTSKERNEL_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include "Utils/CpuFeatures.h"
+
+namespace bin_packing
+{
+	/**
+	 * \brief Whether the kernels can read genes of a given type. Bins of items are stored as int, or as uint8_t and uint16_t
+	 *		  if there are at most 256 and 65536 bins.
+	 */
+	template<typename TGene>
+	struct is_kernel_gene : std::integral_constant<bool, std::is_same<TGene, int>::value || std::is_same<TGene, uint8_t>::value || std::is_same<TGene, uint16_t>::value>
+	{
+	};
+
+	/**
+	 * \brief Maximum number of items whose weights can be summed in a 32-bit integer without an overflow.
+	 *		  SIMD kernels sum blocks of this many items in 32-bit lanes and add the sums to 64-bit weights of bins.
+	 * \param item_weights
+	 * \param items_count
+	 * \return
+	 */
+	inline size_t max_block_items(const int * item_weights, const size_t items_count)
+	{
+		int64_t max_weight = 0;
+
+		for (size_t i = 0; i < items_count; ++i)
+		{
+			max_weight = (std::max)(max_weight, item_weights[i] < 0 ? -static_cast<int64_t>(item_weights[i]) : item_weights[i]);
+		}
+
+		if (max_weight == 0)
+		{
+			return (std::numeric_limits<size_t>::max)();
+		}
+
+		return static_cast<size_t>((std::numeric_limits<int32_t>::max)() / max_weight);
+	}
+
+	/**
+	 * \brief Computes weights of bins by adding weights of items one by one.
+	 * \tparam TGene Type of genes
+	 * \param genes Bins of items
+	 * \param item_weights Weights of items
+	 * \param items_count
+	 * \param bins_count
+	 * \param bin_weights Array of bins_count weights that is overwritten
+	 */
+	template<typename TGene>
+	void scan_bin_weights_scalar(const TGene * genes, const int * item_weights, const size_t items_count, const size_t bins_count, int64_t * bin_weights)
+	{
+		std::fill(bin_weights, bin_weights + bins_count, 0);
+
+		for (size_t i = 0; i < items_count; ++i)
+		{
+			bin_weights[genes[i]] += item_weights[i];
+		}
+	}
+
+	// Blocks of the SIMD kernels must contain at least this many items, otherwise the scalar loop is used
+	const size_t min_block_items = 256;
+
+#ifdef EA_SIMD_X86
+	// Number of bins whose sums are kept in registers during one pass over the items
+	const size_t bins_per_pass = 8;
+
+	/**
+	 * \brief Loads bins of eight items as 32-bit integers.
+	 */
+	EA_TARGET_AVX2 inline __m256i load_bins_avx2(const int * genes)
+	{
+		return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(genes));
+	}
+
+	EA_TARGET_AVX2 inline __m256i load_bins_avx2(const uint16_t * genes)
+	{
+		return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(genes)));
+	}
+
+	EA_TARGET_AVX2 inline __m256i load_bins_avx2(const uint8_t * genes)
+	{
+		return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(genes)));
+	}
+
+	EA_TARGET_AVX2 inline int horizontal_sum_avx2(const __m256i vector)
+	{
+		auto sum = _mm_add_epi32(_mm256_castsi256_si128(vector), _mm256_extracti128_si256(vector, 1));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+
+		return _mm_cvtsi128_si32(sum);
+	}
+
+	/**
+	 * \brief Adds weights of items that are in a given bin to the sums of the bin.
+	 */
+	EA_TARGET_AVX2 inline __m256i add_bin_weights_avx2(const __m256i sums, const __m256i item_bins, const __m256i bin, const __m256i weights)
+	{
+		return _mm256_add_epi32(sums, _mm256_and_si256(_mm256_cmpeq_epi32(item_bins, bin), weights));
+	}
+
+	/**
+	 * \brief Computes weights of bins with AVX2. Eight items are processed at once and the weight of each item
+	 *		  is added to the sum of each bin, masked by the comparison of its bin with the bin of the sum.
+	 *		  Sums of up to eight bins are kept in registers, so more bins need more passes over the items.
+	 *		  Lanes are summed over blocks of block_items items and then added to the weights of bins.
+	 * \remarks Same parameters as scan_bin_weights_scalar. block_items must be a multiple of 16 that is at least 16.
+	 */
+	template<typename TGene>
+	EA_TARGET_AVX2 void scan_bin_weights_avx2(const TGene * genes, const int * item_weights, const size_t items_count, const size_t bins_count, int64_t * bin_weights, const size_t block_items)
+	{
+		const size_t lanes = 8;
+		const auto vectors_end = items_count / lanes * lanes;
+
+		for (size_t first_bin = 0; first_bin < bins_count; first_bin += bins_per_pass)
+		{
+			const auto last_bin = (std::min)(first_bin + bins_per_pass, bins_count);
+			const auto first = static_cast<int>(first_bin);
+
+			// The sums are separate variables so that they stay in registers without relying on loop unrolling
+			const auto bin0 = _mm256_set1_epi32(first);
+			const auto bin1 = _mm256_set1_epi32(first + 1);
+			const auto bin2 = _mm256_set1_epi32(first + 2);
+			const auto bin3 = _mm256_set1_epi32(first + 3);
+			const auto bin4 = _mm256_set1_epi32(first + 4);
+			const auto bin5 = _mm256_set1_epi32(first + 5);
+			const auto bin6 = _mm256_set1_epi32(first + 6);
+			const auto bin7 = _mm256_set1_epi32(first + 7);
+			std::fill(bin_weights + first_bin, bin_weights + last_bin, 0);
+
+			for (size_t block_begin = 0; block_begin < vectors_end; block_begin += block_items)
+			{
+				const auto block_end = (std::min)(block_begin + block_items, vectors_end);
+				auto sums0 = _mm256_setzero_si256();
+				auto sums1 = _mm256_setzero_si256();
+				auto sums2 = _mm256_setzero_si256();
+				auto sums3 = _mm256_setzero_si256();
+				auto sums4 = _mm256_setzero_si256();
+				auto sums5 = _mm256_setzero_si256();
+				auto sums6 = _mm256_setzero_si256();
+				auto sums7 = _mm256_setzero_si256();
+
+				for (auto i = block_begin; i < block_end; i += lanes)
+				{
+					const auto item_bins = load_bins_avx2(genes + i);
+					const auto weights = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(item_weights + i));
+
+					sums0 = add_bin_weights_avx2(sums0, item_bins, bin0, weights);
+					sums1 = add_bin_weights_avx2(sums1, item_bins, bin1, weights);
+					sums2 = add_bin_weights_avx2(sums2, item_bins, bin2, weights);
+					sums3 = add_bin_weights_avx2(sums3, item_bins, bin3, weights);
+					sums4 = add_bin_weights_avx2(sums4, item_bins, bin4, weights);
+					sums5 = add_bin_weights_avx2(sums5, item_bins, bin5, weights);
+					sums6 = add_bin_weights_avx2(sums6, item_bins, bin6, weights);
+					sums7 = add_bin_weights_avx2(sums7, item_bins, bin7, weights);
+				}
+
+				const int sums[bins_per_pass] = {
+					horizontal_sum_avx2(sums0), horizontal_sum_avx2(sums1), horizontal_sum_avx2(sums2), horizontal_sum_avx2(sums3),
+					horizontal_sum_avx2(sums4), horizontal_sum_avx2(sums5), horizontal_sum_avx2(sums6), horizontal_sum_avx2(sums7)
+				};
+
+				for (auto bin = first_bin; bin < last_bin; ++bin)
+				{
+					bin_weights[bin] += sums[bin - first_bin];
+				}
+			}
+
+			for (auto i = vectors_end; i < items_count; ++i)
+			{
+				const auto bin = static_cast<size_t>(genes[i]);
+
+				if (bin >= first_bin && bin < last_bin)
+				{
+					bin_weights[bin] += item_weights[i];
+				}
+			}
+		}
+	}
+
+	/**
+	 * \brief Adds weights of items that are in a given bin to the sums of the bin.
+	 */
+	EA_TARGET_AVX512 inline __m512i add_bin_weights_avx512(const __m512i sums, const __m512i item_bins, const __m512i bin, const __m512i weights, const __mmask16 lanes_mask)
+	{
+		return _mm512_mask_add_epi32(sums, _mm512_mask_cmpeq_epi32_mask(lanes_mask, item_bins, bin), sums, weights);
+	}
+
+	EA_TARGET_AVX512 inline int horizontal_sum_avx512(const __m512i vector)
+	{
+		// Masked shuffles with all lanes set do not use undefined sources, which GCC reports as uninitialized
+		auto sum = _mm512_add_epi32(vector, _mm512_mask_shuffle_i64x2(vector, 0xFF, vector, vector, _MM_SHUFFLE(1, 0, 3, 2)));
+		sum = _mm512_add_epi32(sum, _mm512_mask_shuffle_i64x2(sum, 0xFF, sum, sum, _MM_SHUFFLE(2, 3, 0, 1)));
+		sum = _mm512_add_epi32(sum, _mm512_mask_shuffle_epi32(sum, 0xFFFF, sum, _MM_PERM_BADC));
+		sum = _mm512_add_epi32(sum, _mm512_mask_shuffle_epi32(sum, 0xFFFF, sum, _MM_PERM_CDAB));
+
+		return _mm512_cvtsi512_si32(sum);
+	}
+
+	/**
+	 * \brief Loads bins of up to sixteen items as 32-bit integers. Lanes outside of a given mask are zero.
+	 */
+	EA_TARGET_AVX512 inline __m512i load_bins_avx512(const int * genes, const size_t, const __mmask16 lanes_mask)
+	{
+		return _mm512_maskz_loadu_epi32(lanes_mask, genes);
+	}
+
+	/**
+	 * \remarks Masked loads of bytes and words need AVX-512BW, so genes of the last items are copied to a zeroed buffer.
+	 *		    Zero-masked conversions do not use undefined sources, which GCC reports as uninitialized.
+	 */
+	EA_TARGET_AVX512 inline __m512i load_bins_avx512(const uint16_t * genes, const size_t remaining, const __mmask16 lanes_mask)
+	{
+		if (remaining >= 16)
+		{
+			return _mm512_maskz_cvtepu16_epi32(lanes_mask, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(genes)));
+		}
+
+		uint16_t tail[16] = {};
+		std::copy(genes, genes + remaining, tail);
+
+		return _mm512_maskz_cvtepu16_epi32(lanes_mask, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tail)));
+	}
+
+	EA_TARGET_AVX512 inline __m512i load_bins_avx512(const uint8_t * genes, const size_t remaining, const __mmask16 lanes_mask)
+	{
+		if (remaining >= 16)
+		{
+			return _mm512_maskz_cvtepu8_epi32(lanes_mask, _mm_loadu_si128(reinterpret_cast<const __m128i *>(genes)));
+		}
+
+		uint8_t tail[16] = {};
+		std::copy(genes, genes + remaining, tail);
+
+		return _mm512_maskz_cvtepu8_epi32(lanes_mask, _mm_loadu_si128(reinterpret_cast<const __m128i *>(tail)));
+	}
+
+	/**
+	 * \brief Computes weights of bins with AVX-512. Sixteen items are processed at once and the weight of each item
+	 *		  is added to the sum of each bin under the mask of the comparison of its bin with the bin of the sum.
+	 *		  The remaining items are loaded with a mask, so there is no scalar tail.
+	 *		  Lanes are summed over blocks of block_items items and then added to the weights of bins.
+	 * \remarks Same parameters as scan_bin_weights_avx2.
+	 */
+	template<typename TGene>
+	EA_TARGET_AVX512 void scan_bin_weights_avx512(const TGene * genes, const int * item_weights, const size_t items_count, const size_t bins_count, int64_t * bin_weights, const size_t block_items)
+	{
+		const size_t lanes = 16;
+
+		for (size_t first_bin = 0; first_bin < bins_count; first_bin += bins_per_pass)
+		{
+			const auto last_bin = (std::min)(first_bin + bins_per_pass, bins_count);
+			const auto first = static_cast<int>(first_bin);
+
+			const auto bin0 = _mm512_set1_epi32(first);
+			const auto bin1 = _mm512_set1_epi32(first + 1);
+			const auto bin2 = _mm512_set1_epi32(first + 2);
+			const auto bin3 = _mm512_set1_epi32(first + 3);
+			const auto bin4 = _mm512_set1_epi32(first + 4);
+			const auto bin5 = _mm512_set1_epi32(first + 5);
+			const auto bin6 = _mm512_set1_epi32(first + 6);
+			const auto bin7 = _mm512_set1_epi32(first + 7);
+			std::fill(bin_weights + first_bin, bin_weights + last_bin, 0);
+
+			for (size_t block_begin = 0; block_begin < items_count; block_begin += block_items)
+			{
+				const auto block_end = (std::min)(block_begin + block_items, items_count);
+				auto sums0 = _mm512_setzero_si512();
+				auto sums1 = _mm512_setzero_si512();
+				auto sums2 = _mm512_setzero_si512();
+				auto sums3 = _mm512_setzero_si512();
+				auto sums4 = _mm512_setzero_si512();
+				auto sums5 = _mm512_setzero_si512();
+				auto sums6 = _mm512_setzero_si512();
+				auto sums7 = _mm512_setzero_si512();
+
+				for (auto i = block_begin; i < block_end; i += lanes)
+				{
+					const auto remaining = block_end - i;
+					const auto lanes_mask = static_cast<__mmask16>(remaining >= lanes ? 0xFFFF : (1u << remaining) - 1);
+					const auto item_bins = load_bins_avx512(genes + i, remaining, lanes_mask);
+					const auto weights = _mm512_maskz_loadu_epi32(lanes_mask, item_weights + i);
+
+					sums0 = add_bin_weights_avx512(sums0, item_bins, bin0, weights, lanes_mask);
+					sums1 = add_bin_weights_avx512(sums1, item_bins, bin1, weights, lanes_mask);
+					sums2 = add_bin_weights_avx512(sums2, item_bins, bin2, weights, lanes_mask);
+					sums3 = add_bin_weights_avx512(sums3, item_bins, bin3, weights, lanes_mask);
+					sums4 = add_bin_weights_avx512(sums4, item_bins, bin4, weights, lanes_mask);
+					sums5 = add_bin_weights_avx512(sums5, item_bins, bin5, weights, lanes_mask);
+					sums6 = add_bin_weights_avx512(sums6, item_bins, bin6, weights, lanes_mask);
+					sums7 = add_bin_weights_avx512(sums7, item_bins, bin7, weights, lanes_mask);
+				}
+
+				const int sums[bins_per_pass] = {
+					horizontal_sum_avx512(sums0), horizontal_sum_avx512(sums1), horizontal_sum_avx512(sums2), horizontal_sum_avx512(sums3),
+					horizontal_sum_avx512(sums4), horizontal_sum_avx512(sums5), horizontal_sum_avx512(sums6), horizontal_sum_avx512(sums7)
+				};
+
+				for (auto bin = first_bin; bin < last_bin; ++bin)
+				{
+					bin_weights[bin] += sums[bin - first_bin];
+				}
+			}
+		}
+	}
+#endif
+
+	/**
+	 * \brief Computes weights of bins with the kernel of a given instruction set.
+	 * \tparam TGene Type of genes, see is_kernel_gene
+	 * \param genes Bins of items
+	 * \param item_weights Weights of items
+	 * \param items_count
+	 * \param bins_count
+	 * \param bin_weights Array of bins_count weights that is overwritten
+	 * \param level Must be supported by the CPU, see ea::supported_simd_level
+	 * \param block_items Number of items whose weights fit to a 32-bit sum, see max_block_items
+	 * \remarks The cost of the SIMD kernels grows with the number of bins. AVX2 is used for up to 8 bins and AVX-512 for up to 16 bins,
+	 *		    more bins are faster with the scalar loop. Weights of items that are too heavy to be summed in blocks of min_block_items
+	 *		    items in 32-bit lanes are also added by the scalar loop.
+	 */
+	template<typename TGene>
+	void scan_bin_weights(const TGene * genes, const int * item_weights, const size_t items_count, const size_t bins_count, int64_t * bin_weights, const ea::SimdLevel level, const size_t block_items)
+	{
+		static_assert(is_kernel_gene<TGene>::value, "The kernels read genes of type int, uint8_t or uint16_t");
+
+#ifdef EA_SIMD_X86
+		// Blocks are whole vectors of both kernels
+		const auto block = block_items / 16 * 16;
+
+		if (level == ea::SimdLevel::avx512 && bins_count <= 2 * bins_per_pass && block_items >= min_block_items)
+		{
+			scan_bin_weights_avx512(genes, item_weights, items_count, bins_count, bin_weights, block);
+			return;
+		}
+
+		if (level >= ea::SimdLevel::avx2 && bins_count <= bins_per_pass && block_items >= min_block_items)
+		{
+			scan_bin_weights_avx2(genes, item_weights, items_count, bins_count, bin_weights, block);
+			return;
+		}
+#else
+		(void)level;
+		(void)block_items;
+#endif
+
+		scan_bin_weights_scalar(genes, item_weights, items_count, bins_count, bin_weights);
+	}
+}
+#endif // BINWEIGHTSKERNEL_H
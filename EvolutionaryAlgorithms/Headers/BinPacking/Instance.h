@@ -0,0 +1,319 @@
+#ifndef INSTANCE_H
+#define INSTANCE_H
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Utils/MappedFile.h"
+
+namespace bin_packing
+{
+	/**
+	 * \brief Magic bytes at the beginning of binary instances.
+	 */
+	const char binary_instance_magic[8] = { 'E', 'A', 'B', 'P', 'I', 'N', 'S', 'T' };
+
+	/**
+	 * \brief Version of the binary instance format.
+	 */
+	const uint32_t binary_instance_version = 1;
+
+	/**
+	 * \brief Header of a binary instance. It is followed by the weights as 32-bit integers in the byte order of the machine.
+	 */
+	struct BinaryInstanceHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t header_bytes;
+		uint64_t byte_order; // 0x0102030405060708 as written by the machine
+		uint64_t items_count;
+	};
+
+	static_assert(sizeof(BinaryInstanceHeader) == 32, "The instance header must not contain padding");
+
+	/**
+	 * \brief Parses a decimal integer without allocating or consulting the locale.
+	 * \param first First character of the number
+	 * \param last End of the text
+	 * \param value Set to the parsed value
+	 * \return Pointer behind the last digit or nullptr if there is no number or it does not fit to an int
+	 */
+	inline const char * parse_int(const char * first, const char * last, int & value)
+	{
+		const auto negative = first != last && *first == '-';
+
+		if (negative)
+		{
+			++first;
+		}
+
+		if (first == last || *first < '0' || *first > '9')
+		{
+			return nullptr;
+		}
+
+		// Accumulate in the negative range, which can hold the magnitude of std::numeric_limits<int>::min
+		const auto limit = (std::numeric_limits<int>::min)();
+		int result = 0;
+
+		for (; first != last && *first >= '0' && *first <= '9'; ++first)
+		{
+			const auto digit = *first - '0';
+
+			if (result < (limit + digit) / 10)
+			{
+				return nullptr;
+			}
+
+			result = result * 10 - digit;
+		}
+
+		if (!negative)
+		{
+			if (result == limit)
+			{
+				return nullptr;
+			}
+
+			result = -result;
+		}
+
+		value = result;
+
+		return first;
+	}
+
+	/**
+	 * \brief Parses weights of items, one integer per line. Spaces around the numbers and empty lines are ignored.
+	 * \param first
+	 * \param last
+	 * \param weights Weights are appended to this array
+	 * \return nullptr on success, otherwise the beginning of the invalid line
+	 */
+	inline const char * parse_weights(const char * first, const char * last, std::vector<int> & weights)
+	{
+		while (first != last)
+		{
+			const auto line = first;
+
+			while (first != last && (*first == ' ' || *first == '\t'))
+			{
+				++first;
+			}
+
+			if (first != last && *first != '\n' && *first != '\r')
+			{
+				int weight;
+				first = parse_int(first, last, weight);
+
+				if (first == nullptr)
+				{
+					return line;
+				}
+
+				weights.push_back(weight);
+
+				while (first != last && (*first == ' ' || *first == '\t'))
+				{
+					++first;
+				}
+			}
+
+			if (first != last && *first == '\r')
+			{
+				++first;
+			}
+
+			if (first != last)
+			{
+				if (*first != '\n')
+				{
+					return line;
+				}
+
+				++first;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/**
+	 * \brief Number of the line that contains a given character, starting from 1.
+	 * \param first Beginning of the text
+	 * \param position
+	 * \return
+	 */
+	inline size_t line_number(const char * first, const char * position)
+	{
+		return static_cast<size_t>(std::count(first, position, '\n')) + 1;
+	}
+
+	/**
+	 * \brief Whether given contents start with the header of a binary instance.
+	 * \param data
+	 * \param size
+	 * \return
+	 */
+	inline bool is_binary_instance(const char * data, const size_t size)
+	{
+		return size >= sizeof(BinaryInstanceHeader) && std::memcmp(data, binary_instance_magic, sizeof(binary_instance_magic)) == 0;
+	}
+
+	/**
+	 * \brief Reads weights from the contents of a binary instance.
+	 * \param data
+	 * \param size
+	 * \param path Path of the file, used in error messages
+	 * \return
+	 */
+	inline std::vector<int> read_binary_weights(const char * data, const size_t size, const std::string & path)
+	{
+		BinaryInstanceHeader header;
+		std::memcpy(&header, data, sizeof(header));
+
+		if (header.version != binary_instance_version || header.header_bytes != sizeof(BinaryInstanceHeader))
+			throw std::runtime_error("The instance " + path + " has an unsupported version " + std::to_string(header.version));
+
+		if (header.byte_order != 0x0102030405060708)
+			throw std::runtime_error("The instance " + path + " was written on a machine with a different byte order");
+
+		if ((size - sizeof(BinaryInstanceHeader)) / sizeof(int32_t) != header.items_count || (size - sizeof(BinaryInstanceHeader)) % sizeof(int32_t) != 0)
+			throw std::runtime_error("The instance " + path + " is truncated");
+
+		if (header.items_count == 0)
+			throw std::runtime_error("No weights in " + path);
+
+		std::vector<int> weights(static_cast<size_t>(header.items_count));
+		static_assert(sizeof(int) == sizeof(int32_t), "Weights are stored as 32-bit integers");
+		std::memcpy(weights.data(), data + sizeof(BinaryInstanceHeader), weights.size() * sizeof(int32_t));
+
+		return weights;
+	}
+
+	/**
+	 * \brief Loads weights of items from a text file with one weight per line or from a binary instance (see save_weights_binary).
+	 *		  Throws std::runtime_error if the file cannot be read, a line is not a valid weight or there are no weights.
+	 * \remarks The file is memory-mapped. Big text files are split into chunks at line boundaries that are parsed in parallel.
+	 * \param path
+	 * \param threads Maximum number of threads that parse a text file, 0 uses all hardware threads
+	 * \return
+	 */
+	inline std::vector<int> load_weights(const std::string & path, size_t threads = 1)
+	{
+		const ea::MappedFile file(path);
+		const auto first = file.data();
+		const auto last = first + file.size();
+
+		if (is_binary_instance(first, file.size()))
+		{
+			return read_binary_weights(first, file.size(), path);
+		}
+
+		// Small chunks are not worth a thread
+		const size_t min_chunk_bytes = 1 << 20;
+
+		if (threads == 0)
+		{
+			threads = (std::max)(1u, std::thread::hardware_concurrency());
+		}
+
+		threads = (std::max)(size_t{ 1 }, (std::min)(threads, file.size() / min_chunk_bytes));
+
+		// Every chunk ends behind a new line, so that no line is split
+		std::vector<const char *> bounds{ first };
+
+		for (size_t i = 1; i < threads; ++i)
+		{
+			auto bound = (std::max)(bounds.back(), first + file.size() * i / threads);
+			bound = std::find(bound, last, '\n');
+			bounds.push_back(bound == last ? last : bound + 1);
+		}
+
+		bounds.push_back(last);
+
+		std::vector<std::vector<int>> chunks(threads);
+		std::vector<const char *> errors(threads, nullptr);
+		std::vector<std::thread> workers;
+
+		for (size_t i = 1; i < threads; ++i)
+		{
+			workers.emplace_back([&, i]() { errors[i] = parse_weights(bounds[i], bounds[i + 1], chunks[i]); });
+		}
+
+		// Roughly one weight per 6 characters
+		chunks[0].reserve((bounds[1] - bounds[0]) / 6);
+		errors[0] = parse_weights(bounds[0], bounds[1], chunks[0]);
+
+		for (auto && worker : workers)
+		{
+			worker.join();
+		}
+
+		for (auto && error : errors)
+		{
+			if (error != nullptr)
+				throw std::runtime_error("Invalid weight on line " + std::to_string(line_number(first, error)) + " of " + path);
+		}
+
+		auto weights = std::move(chunks[0]);
+
+		for (size_t i = 1; i < threads; ++i)
+		{
+			weights.insert(weights.end(), chunks[i].begin(), chunks[i].end());
+		}
+
+		if (weights.empty())
+			throw std::runtime_error("No weights in " + path);
+
+		return weights;
+	}
+
+	/**
+	 * \brief Saves weights of items as a binary instance that load_weights reads without parsing.
+	 * \param path
+	 * \param weights
+	 */
+	inline void save_weights_binary(const std::string & path, const std::vector<int> & weights)
+	{
+		BinaryInstanceHeader header{};
+		std::memcpy(header.magic, binary_instance_magic, sizeof(binary_instance_magic));
+		header.version = binary_instance_version;
+		header.header_bytes = sizeof(BinaryInstanceHeader);
+		header.byte_order = 0x0102030405060708;
+		header.items_count = weights.size();
+
+		const auto file = std::fopen(path.c_str(), "wb");
+
+		if (file == nullptr)
+			throw std::runtime_error("Cannot create " + path);
+
+		auto written = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+		if (!weights.empty())
+		{
+			written = written && std::fwrite(weights.data(), sizeof(int), weights.size(), file) == weights.size();
+		}
+
+		if (std::fclose(file) != 0 || !written)
+			throw std::runtime_error("Cannot write " + path);
+	}
+
+	/**
+	 * \brief Converts an instance in the text format (e.g. packingInput-harder.txt) to the binary format.
+	 * \param text_path
+	 * \param binary_path
+	 * \param threads Maximum number of threads that parse the text file, 0 uses all hardware threads
+	 */
+	inline void convert_weights_to_binary(const std::string & text_path, const std::string & binary_path, const size_t threads = 0)
+	{
+		save_weights_binary(binary_path, load_weights(text_path, threads));
+	}
+}
+#endif // INSTANCE_H
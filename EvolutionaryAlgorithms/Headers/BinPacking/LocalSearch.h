@@ -0,0 +1,324 @@
+#ifndef LOCALSEARCH_H
+#define LOCALSEARCH_H
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "BinPacking/BinPackingFitness.h"
+#include "Utils/Random.h"
+#include "Utils/ThreadPool.h"
+#include "Utils/Utils.h"
+
+namespace bin_packing
+{
+	/**
+	 * \brief The three heaviest and the three lightest bins.
+	 * \remarks A move or a swap changes the weights of two bins, so the heaviest and the lightest of the other bins
+	 *		    are among these. The objective after any move is then computed in O(1).
+	 */
+	class BinRanking
+	{
+		static const size_t ranked = 3;
+
+		const int64_t * weights_ = nullptr;
+		size_t heaviest_[ranked] = {};
+		size_t lightest_[ranked] = {};
+		size_t count_ = 0;
+
+		/**
+		 * \brief Inserts a bin to an array of ranked bins that is sorted by a given order.
+		 * \param bins
+		 * \param filled Number of bins in the array
+		 * \param bin
+		 * \param before Whether a bin is ranked before another one
+		 */
+		template<typename TOrder>
+		void insert(size_t * bins, const size_t filled, const size_t bin, const TOrder & before) const
+		{
+			if (filled == count_ && !before(bin, bins[count_ - 1]))
+			{
+				return;
+			}
+
+			auto position = (std::min)(filled, count_ - 1);
+
+			for (; position > 0 && before(bin, bins[position - 1]); --position)
+			{
+				bins[position] = bins[position - 1];
+			}
+
+			bins[position] = bin;
+		}
+
+	public:
+		/**
+		 * \brief Ranks the bins in O(bins).
+		 * \param weights Weights of bins
+		 * \param bins_count Must be at least 1
+		 */
+		// Not std::min, it would bind ranked to a reference and ranked has no definition
+		BinRanking(const int64_t * weights, const size_t bins_count) : weights_(weights), count_(bins_count < ranked ? bins_count : ranked)
+		{
+			const auto heavier = [weights](const size_t first, const size_t second) { return weights[first] > weights[second]; };
+			const auto lighter = [weights](const size_t first, const size_t second) { return weights[first] < weights[second]; };
+
+			for (size_t bin = 0; bin < bins_count; ++bin)
+			{
+				insert(heaviest_, (std::min)(bin, count_), bin, heavier);
+				insert(lightest_, (std::min)(bin, count_), bin, lighter);
+			}
+		}
+
+		/**
+		 * \brief The heaviest bin.
+		 * \return
+		 */
+		size_t heaviest() const
+		{
+			return heaviest_[0];
+		}
+
+		/**
+		 * \brief The lightest bin.
+		 * \return
+		 */
+		size_t lightest() const
+		{
+			return lightest_[0];
+		}
+
+		/**
+		 * \brief The difference between the heaviest and the lightest bin.
+		 * \return
+		 */
+		int64_t objective() const
+		{
+			return weights_[heaviest_[0]] - weights_[lightest_[0]];
+		}
+
+		/**
+		 * \brief The difference between the heaviest and the lightest bin after the weights of two bins change.
+		 * \param first
+		 * \param first_weight New weight of the first bin
+		 * \param second
+		 * \param second_weight New weight of the second bin
+		 * \return
+		 */
+		int64_t objective_after(const size_t first, const int64_t first_weight, const size_t second, const int64_t second_weight) const
+		{
+			auto max = (std::max)(first_weight, second_weight);
+			auto min = (std::min)(first_weight, second_weight);
+
+			for (size_t i = 0; i < count_; ++i)
+			{
+				if (heaviest_[i] != first && heaviest_[i] != second)
+				{
+					max = (std::max)(max, weights_[heaviest_[i]]);
+					break;
+				}
+			}
+
+			for (size_t i = 0; i < count_; ++i)
+			{
+				if (lightest_[i] != first && lightest_[i] != second)
+				{
+					min = (std::min)(min, weights_[lightest_[i]]);
+					break;
+				}
+			}
+
+			return max - min;
+		}
+	};
+
+	/**
+	 * \brief Memetic operator for the bin packing problem. Chosen individuals are improved by a bounded local search.
+	 * \tparam TPopulation Type of the population
+	 * \remarks Every step ranks the bins and samples candidate moves: an item is moved to the lightest bin, or it is swapped
+	 *		    with an item of another bin. Each candidate is scored exactly from the weights of bins in O(1), so a step costs
+	 *		    O(bins + candidates) instead of a scan of all items. The best candidate is applied if it lowers the difference
+	 *		    between the heaviest and the lightest bin. Individuals are searched in parallel and each of them draws
+	 *		    from its own random stream, so the result does not depend on the number of threads.
+	 */
+	template<typename TPopulation>
+	class BinPackingLocalSearch
+	{
+		using individual_type = typename TPopulation::value_type;
+		using element_type = typename individual_type::element_type;
+
+		const BinPackingFitness<TPopulation> & fitness_;
+		double search_probability_;
+		size_t max_steps_;
+		size_t candidates_;
+		std::shared_ptr<ea::ThreadPool> pool_;
+
+		// Buffers kept between calls
+		std::vector<double> individual_uniforms_;
+		std::vector<size_t> chosen_;
+
+		/**
+		 * \brief Draws a random item.
+		 */
+		static size_t random_item(ea::RandomStream & random, const size_t items_count)
+		{
+			return (std::min)(static_cast<size_t>(random.uniform() * items_count), items_count - 1);
+		}
+
+		/**
+		 * \brief Searches the neighbourhood of a single individual.
+		 * \param individual
+		 * \param random
+		 */
+		void search(individual_type & individual, ea::RandomStream & random) const
+		{
+			const auto & item_weights = fitness_.weights();
+			const auto items_count = individual.size();
+
+			if (items_count == 0)
+			{
+				return;
+			}
+
+			// Reuse the buffer of the current thread so that the search does not allocate
+			thread_local std::vector<int64_t> bin_weights;
+			fitness_.get_bin_weights(individual, bin_weights);
+
+			for (size_t step = 0; step < max_steps_; ++step)
+			{
+				const BinRanking ranking(bin_weights.data(), bin_weights.size());
+				const auto lightest = ranking.lightest();
+				auto best_objective = ranking.objective();
+
+				if (best_objective == 0)
+				{
+					return;
+				}
+
+				// The best candidate, swapped_item is items_count for a move
+				auto best_item = items_count;
+				auto swapped_item = items_count;
+				size_t target_bin = 0;
+
+				for (size_t candidate = 0; candidate < candidates_; ++candidate)
+				{
+					const auto item = random_item(random, items_count);
+					const auto bin = static_cast<size_t>(individual[item]);
+					const int64_t weight = item_weights[item];
+
+					// Move the item to the lightest bin
+					if (bin != lightest)
+					{
+						const auto objective = ranking.objective_after(bin, bin_weights[bin] - weight, lightest, bin_weights[lightest] + weight);
+
+						if (objective < best_objective)
+						{
+							best_objective = objective;
+							best_item = item;
+							swapped_item = items_count;
+							target_bin = lightest;
+						}
+					}
+
+					// Swap the item with an item of another bin
+					const auto other_item = random_item(random, items_count);
+					const auto other_bin = static_cast<size_t>(individual[other_item]);
+					const auto difference = weight - item_weights[other_item];
+
+					if (other_bin != bin && difference != 0)
+					{
+						const auto objective = ranking.objective_after(bin, bin_weights[bin] - difference, other_bin, bin_weights[other_bin] + difference);
+
+						if (objective < best_objective)
+						{
+							best_objective = objective;
+							best_item = item;
+							swapped_item = other_item;
+							target_bin = other_bin;
+						}
+					}
+				}
+
+				if (best_item == items_count)
+				{
+					continue;
+				}
+
+				const auto source_bin = static_cast<size_t>(individual[best_item]);
+				bin_weights[source_bin] -= item_weights[best_item];
+				bin_weights[target_bin] += item_weights[best_item];
+				individual.set(best_item, static_cast<element_type>(target_bin));
+
+				if (swapped_item != items_count)
+				{
+					bin_weights[target_bin] -= item_weights[swapped_item];
+					bin_weights[source_bin] += item_weights[swapped_item];
+					individual.set(swapped_item, static_cast<element_type>(source_bin));
+				}
+			}
+		}
+
+	public:
+		/**
+		 * \brief
+		 * \param fitness Fitness function that knows weights of items and the number of bins. Must outlive the operator.
+		 * \param search_probability The probability of searching an individual.
+		 * \param max_steps Maximum number of steps of the search of an individual. Each step applies at most one move or swap.
+		 * \param candidates Number of sampled items in each step. Each of them is scored as a move and as a swap.
+		 * \param pool Thread pool that searches individuals, usually the fitness pool of the algorithm (see fitness_pool),
+		 *		  so that the operator does not start threads of its own. nullptr searches them on the calling thread.
+		 */
+		BinPackingLocalSearch(const BinPackingFitness<TPopulation> & fitness, const double search_probability, const size_t max_steps = 50, const size_t candidates = 16, std::shared_ptr<ea::ThreadPool> pool = nullptr)
+			: fitness_(fitness), search_probability_(search_probability), max_steps_(max_steps), candidates_(candidates), pool_(std::move(pool))
+		{
+			if (search_probability < 0 || search_probability > 1)
+				throw std::invalid_argument("search_probability must be from the interval [0,1]");
+
+			if (fitness.bins_count() < 2 || fitness.bins_count() - 1 > static_cast<size_t>((std::numeric_limits<element_type>::max)()))
+				throw std::invalid_argument("Elements of individuals must hold indices of at least two bins");
+		}
+
+		/**
+		 * \brief Chooses individuals with the search probability and searches their neighbourhoods.
+		 * \param population The population that is changed by the operator.
+		 */
+		void operator()(TPopulation & population)
+		{
+			individual_uniforms_.resize(population.size());
+			ea::rng_gen().fill_uniform(individual_uniforms_.data(), individual_uniforms_.size());
+			chosen_.clear();
+
+			for (size_t i = 0; i < population.size(); ++i)
+			{
+				if (individual_uniforms_[i] < search_probability_)
+				{
+					chosen_.push_back(i);
+				}
+			}
+
+			// Streams of individuals are split from the stream of the generation on the calling thread
+			const auto & generation_stream = ea::rng_gen();
+
+			const auto search_range = [&](const size_t begin, const size_t end)
+			{
+				for (auto i = begin; i < end; ++i)
+				{
+					auto random = generation_stream.split(static_cast<uint32_t>(chosen_[i]));
+					search(population[chosen_[i]], random);
+				}
+			};
+
+			if (pool_ != nullptr)
+			{
+				pool_->parallel_for(chosen_.size(), search_range);
+			}
+			else
+			{
+				search_range(0, chosen_.size());
+			}
+		}
+	};
+}
+#endif // LOCALSEARCH_H
@@ -3,6 +3,28 @@
 #include <functional>
 #include <vector>
 #include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include "Utils/Checkpoint.h"
+#include "Utils/Instrumentation.h"
+#include "Utils/ProgressLog.h"
+#include "Utils/RunControl.h"
+#include "Utils/Selection.h"
+#include "Utils/StageTimes.h"
+#include "Utils/Termination.h"
+#include "Utils/ThreadPool.h"
+#include "Utils/Utils.h"
 
 namespace ea
 {
@@ -18,50 +40,420 @@ namespace ea
 		using selector_type = std::function<void(const TPopulation &, TPopulation &, size_t)>;
 		using fitness_fnc_type = std::function<void(TPopulation &)>;
 		using individual_type = typename TPopulation::value_type;
+		using individual_fitness_fnc_type = std::function<void(individual_type &)>;
 		using fitness_value_type = typename individual_type::fitness_type;
 		using objective_fnc_type = std::function<fitness_value_type(individual_type &)>;
 		using population_initializer_type = std::function<TPopulation()>;
 		using individual_to_string_type = std::function<std::string(individual_type&)>;
+		using stop_condition_type = std::function<bool(const RunProgress<fitness_value_type> &)>;
+		using run_control_type = RunControl<individual_type, fitness_value_type>;
 
 		std::vector<operator_type> operators_;
 		std::vector<selector_type> mating_selectors_;
 		std::vector<selector_type> natural_selectors_;
 		fitness_fnc_type fitness_;
+		individual_fitness_fnc_type individual_fitness_;
 		objective_fnc_type objective_fnc_;
 		individual_to_string_type individual_to_string_;
 
 		size_t output_frequency_ = 1;
+		std::shared_ptr<ProgressLogger> progress_logger_;
 
 		bool elitism_enabled_ = false;
 		double elitism_percentage_ = 0;
 
+		std::shared_ptr<ThreadPool> fitness_pool_;
+		stage_observer_type stage_observer_;
+
+		counter_sink_type counter_sink_;
+		size_t counted_generations_ = 0;
+		counter_values last_counters_{};
+
+		// Buffers that are kept between generations
+		TPopulation offspring_{};
+		std::vector<std::pair<fitness_value_type, size_t>> elite_candidates_;
+		size_t batch_threads_ = 1;
+
+		bool seed_set_ = false;
+		uint64_t seed_ = 0;
+
+		// Index of the best individual in the population that was created by the last call of evolve
+		size_t best_index_ = 0;
+
+		// Stop conditions
+		ObjectiveDirection objective_direction_ = ObjectiveDirection::minimize;
+		bool objective_bound_set_ = false;
+		fitness_value_type objective_bound_{};
+		bool target_objective_set_ = false;
+		fitness_value_type target_objective_{};
+		size_t stagnation_limit_ = 0;
+		size_t max_evaluations_ = 0;
+		std::chrono::steady_clock::duration time_limit_{ 0 };
+		std::vector<stop_condition_type> stop_conditions_;
+
+		// Shared with the threads that cancel the run or read the best individual, copied with the algorithm
+		std::shared_ptr<run_control_type> run_control_;
+
+		// Checkpoints
+		std::string checkpoint_path_;
+		size_t checkpoint_generations_ = 0;
+		std::chrono::steady_clock::duration checkpoint_interval_{ 0 };
+		std::shared_ptr<CheckpointWriter> checkpoint_writer_;
+
+		size_t evaluations_ = 0;
+		RunResult run_result_{};
+		std::vector<RunResult> batch_results_;
+
+		/**
+		 * \brief Whether the run control asks the run to stop.
+		 * \return
+		 */
+		bool stop_requested() const
+		{
+			return run_control_ && run_control_->stop_requested();
+		}
+
 		/**
-		 * \brief Finds the best individual.
+		 * \brief Adds evaluated individuals to the number of evaluations.
+		 * \param count
+		 */
+		void count_evaluations(const size_t count)
+		{
+			EA_COUNT(evaluations, count);
+			evaluations_ += count;
+		}
+
+		/**
+		 * \brief Whether an objective value is at least as good as a given value.
+		 * \param objective
+		 * \param value
+		 * \return
+		 */
+		bool reaches(const fitness_value_type objective, const fitness_value_type value) const
+		{
+			return objective_direction_ == ObjectiveDirection::minimize ? objective <= value : objective >= value;
+		}
+
+		/**
+		 * \brief Checks the stop conditions after a generation.
+		 * \param best The best individual of the current population
+		 * \param progress
+		 * \param reason Set to the reason of the stop
+		 * \return Whether the run should stop
+		 */
+		bool should_stop(individual_type & best, RunProgress<fitness_value_type> & progress, StopReason & reason)
+		{
+			if (objective_bound_set_ || target_objective_set_ || !stop_conditions_.empty())
+			{
+				progress.best_objective = objective(best);
+			}
+
+			if (objective_bound_set_ && reaches(progress.best_objective, objective_bound_))
+			{
+				reason = StopReason::optimum;
+			}
+			else if (target_objective_set_ && reaches(progress.best_objective, target_objective_))
+			{
+				reason = StopReason::target_objective;
+			}
+			else if (stagnation_limit_ != 0 && progress.stagnant_generations >= stagnation_limit_)
+			{
+				reason = StopReason::stagnation;
+			}
+			else if (max_evaluations_ != 0 && progress.evaluations >= max_evaluations_)
+			{
+				reason = StopReason::evaluations;
+			}
+			else if (time_limit_.count() != 0 && progress.elapsed >= time_limit_)
+			{
+				reason = StopReason::time_limit;
+			}
+			else if (std::any_of(stop_conditions_.begin(), stop_conditions_.end(), [&](const stop_condition_type & condition) { return condition(progress); }))
+			{
+				reason = StopReason::stop_condition;
+			}
+			else
+			{
+				return false;
+			}
+
+			return true;
+		}
+
+		/**
+		 * \brief Finds the best individual by scanning the population. Populations created by evolve should use best_index instead.
 		 * \param population 
 		 * \return 
 		 */
 		individual_type & get_best_individual(TPopulation & population)
 		{
-			return *(std::max_element(population.begin(), population.end(), [](auto i1, auto i2) { return i1.fitness < i2.fitness; }));
+			return *(std::max_element(population.begin(), population.end(), [](const individual_type & i1, const individual_type & i2) { return i1.fitness < i2.fitness; }));
 		}
 
 		/**
-		 * \brief Helper function that computes how many individuals should we select in idividual selectors
-		 * \param selector_order 
-		 * \param total_selectors 
-		 * \param elements_to_select 
-		 * \return 
+		 * \brief Sends the counters of the last generation to the counter sink.
 		 */
-		size_t how_many_should_select(const size_t selector_order, const size_t total_selectors, const size_t elements_to_select) const
+		void report_counters()
 		{
-			const auto each = static_cast<int>(std::floor(elements_to_select / static_cast<double>(total_selectors)));
+			CounterSnapshot snapshot;
+			snapshot.generation = ++counted_generations_;
+			snapshot.totals = collect_counters();
 
-			if (selector_order < total_selectors - 1)
+			for (size_t i = 0; i < counters_count; ++i)
 			{
-				return each;
+				// Counters could have been reset since the last snapshot
+				snapshot.generation_values[i] = snapshot.totals[i] >= last_counters_[i] ? snapshot.totals[i] - last_counters_[i] : snapshot.totals[i];
 			}
 
-			return elements_to_select - (total_selectors - 1) * each;
+			last_counters_ = snapshot.totals;
+			counter_sink_(snapshot);
+		}
+
+		/**
+		 * \brief Whether a checkpoint should be written after a given generation.
+		 * \param generation Number of completed generations
+		 * \param last_checkpoint Time of the last checkpoint
+		 * \return
+		 */
+		bool checkpoint_due(const size_t generation, const std::chrono::steady_clock::time_point last_checkpoint) const
+		{
+			return checkpoint_writer_
+				&& ((checkpoint_generations_ != 0 && generation % checkpoint_generations_ == 0)
+				|| (checkpoint_interval_.count() != 0 && std::chrono::steady_clock::now() - last_checkpoint >= checkpoint_interval_));
+		}
+
+		/**
+		 * \brief Copies the population and the state of the run and hands them over to the checkpoint writer.
+		 * \param population
+		 * \param state
+		 */
+		void write_checkpoint(const TPopulation & population, CheckpointState<fitness_value_type> & state)
+		{
+			state.seed = rng_gen().seed();
+			state.stream = rng_gen().id();
+			state.rng_position = rng_gen().position();
+			checkpoint_writer_->submit(checkpoint_path(state.stream.run), serialize_checkpoint(state, population));
+		}
+
+		/**
+		 * \brief Pushes a progress record of the current run to the progress logger.
+		 * \param event
+		 * \param population
+		 * \param best The best individual of the population
+		 * \param generation Number of completed generations
+		 * \param elapsed Time of the run
+		 */
+		void log_progress(const ProgressEvent event, const TPopulation & population, individual_type & best, const size_t generation, const std::chrono::steady_clock::duration elapsed)
+		{
+			ProgressRecord record;
+			record.event = event;
+			record.run = rng_gen().id().run;
+			record.island = rng_gen().id().island;
+			record.generation = generation;
+			record.objective = static_cast<double>(objective(best));
+			record.evaluations = evaluations_;
+			record.elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+			record.reason = run_result_.reason;
+
+			if (population.size() != 0)
+			{
+				auto sum = 0.0;
+				record.best_fitness = static_cast<double>(population[0].fitness);
+				record.worst_fitness = record.best_fitness;
+
+				for (auto && individual : population)
+				{
+					const auto fitness = static_cast<double>(individual.fitness);
+					sum += fitness;
+					record.best_fitness = (std::max)(record.best_fitness, fitness);
+					record.worst_fitness = (std::min)(record.worst_fitness, fitness);
+				}
+
+				record.mean_fitness = sum / population.size();
+			}
+
+			progress_logger_->push(std::move(record));
+		}
+
+		/**
+		 * \brief Publishes a copy of a given individual to the progress logger if any of its sinks writes individuals.
+		 *		  The copy is converted to a string later on the thread of the logger.
+		 * \param individual
+		 */
+		void publish_individual(const individual_type & individual)
+		{
+			if (individual_to_string_ && progress_logger_ && progress_logger_->wants_individuals())
+			{
+				progress_logger_->publish_individual(rng_gen().id().run, rng_gen().id().island,
+					std::make_shared<const individual_renderer>([to_string = individual_to_string_, copy = individual]() mutable { return to_string(copy); }));
+			}
+		}
+
+		/**
+		 * \brief Evolves the population from a given state of a run until it stops.
+		 * \param population Population after state.generation generations
+		 * \param state
+		 * \param generations The maximum number of generations
+		 * \param out Stream to which the progress is written
+		 * \return The best individual
+		 */
+		individual_type run(TPopulation population, CheckpointState<fitness_value_type> state, const size_t generations, std::ostream & out)
+		{
+			using clock = std::chrono::steady_clock;
+
+			// The two populations are swapped after every generation so that their storage is reused
+			TPopulation next_pop{};
+
+			// The time of the run includes the time before the checkpoint
+			const auto start = clock::now() - state.elapsed;
+			auto last_checkpoint = clock::now();
+			const auto resumed_finished = state.finished;
+			RunProgress<fitness_value_type> progress{ state.generation, state.evaluations, state.stagnant_generations, fitness_value_type{}, state.elapsed };
+			evaluations_ = state.evaluations;
+			run_result_ = RunResult{};
+			run_result_.generations = state.generation;
+
+			if (state.finished)
+			{
+				run_result_.reason = state.reason;
+			}
+
+			for (auto i = state.generation; i < generations && !state.finished; ++i)
+			{
+				rng_generation(i + 1);
+
+				if (!evolve(population, next_pop))
+				{
+					run_result_.reason = run_control_->cancel_requested() ? StopReason::cancelled : StopReason::deadline;
+					break;
+				}
+
+				std::swap(population, next_pop);
+
+				auto & best = population[best_index_];
+
+				if (i == 0 || state.best_fitness < best.fitness)
+				{
+					state.best_fitness = best.fitness;
+					progress.stagnant_generations = 0;
+
+					// Individuals are copied for the progress logger only when they improve, not with every record
+					publish_individual(best);
+
+					if (run_control_)
+					{
+						run_control_->publish(best, objective(best), i + 1);
+					}
+				}
+				else
+				{
+					++progress.stagnant_generations;
+				}
+
+				// Output progress
+				if (output_frequency_ != 0 && i % output_frequency_ == 0)
+				{
+					if (progress_logger_)
+					{
+						log_progress(ProgressEvent::generation, population, best, i + 1, clock::now() - start);
+					}
+					else
+					{
+						auto objective = this->objective(best);
+
+						out << "gen: " << i << "; obj: " << objective;
+						
+						if (individual_to_string_)
+						{
+							out << "; best ind.: " << individual_to_string_(best);
+						}
+						
+						out << std::endl;
+					}
+				}
+
+				progress.generation = i + 1;
+				progress.evaluations = evaluations_;
+				progress.elapsed = clock::now() - start;
+				run_result_.generations = i + 1;
+
+				state.generation = i + 1;
+				state.evaluations = evaluations_;
+				state.stagnant_generations = progress.stagnant_generations;
+				state.elapsed = progress.elapsed;
+
+				if (should_stop(best, progress, run_result_.reason))
+				{
+					break;
+				}
+
+				if (checkpoint_due(i + 1, last_checkpoint))
+				{
+					write_checkpoint(population, state);
+					last_checkpoint = clock::now();
+				}
+			}
+
+			run_result_.evaluations = evaluations_;
+
+			// The final checkpoint lets a resumed run stop right away or continue with more generations
+			if (checkpoint_writer_ && !resumed_finished)
+			{
+				state.reason = run_result_.reason;
+				state.finished = run_result_.reason != StopReason::generations && run_result_.reason != StopReason::cancelled && run_result_.reason != StopReason::deadline;
+				write_checkpoint(population, state);
+				checkpoint_writer_->flush();
+			}
+
+			// Output total results
+			auto & total_best = run_result_.generations == 0 ? get_best_individual(population) : population[best_index_];
+
+			if (progress_logger_)
+			{
+				publish_individual(total_best);
+				log_progress(ProgressEvent::finished, population, total_best, run_result_.generations, clock::now() - start);
+
+				// Individuals may refer to objects that do not outlive the run, so they are rendered before it returns
+				progress_logger_->flush();
+				progress_logger_->publish_individual(rng_gen().id().run, rng_gen().id().island, nullptr);
+
+				return total_best;
+			}
+
+			auto total_objective = objective(total_best);
+			out << "<< FINISHED >> best obj: " << total_objective << "; generations: " << run_result_.generations << "; stopped: " << stop_reason_name(run_result_.reason);
+
+			if (individual_to_string_)
+			{
+				out << "; best ind.: " << individual_to_string_(total_best);
+			}
+
+			out << std::endl;
+
+			// Return the best individual
+			return total_best;
+		}
+
+		/**
+		 * \brief Evolves a single run of a batch. The run continues from its checkpoint if there is one.
+		 * \param run Index of the run
+		 * \param master_seed
+		 * \param generations
+		 * \param population_initializer
+		 * \param out Stream to which the progress is written
+		 * \return The best individual
+		 */
+		individual_type evolve_run(const size_t run, const uint64_t master_seed, const size_t generations, population_initializer_type & population_initializer, std::ostream & out)
+		{
+			if (checkpoint_writer_ && checkpoint_exists(checkpoint_path(run)))
+			{
+				return resume(checkpoint_path(run), generations, out);
+			}
+
+			rng_seed(master_seed, StreamId{ run });
+			auto initial_pop = population_initializer();
+
+			return evolve(initial_pop, generations, out);
 		}
 
 	public:
@@ -105,6 +497,86 @@ namespace ea
 			this->fitness_ = fitness;
 		}
 
+		/**
+		 * \brief Sets a fitness function that evaluates a single individual.
+		 * \remarks If no population fitness function is set, this function is called for every individual.
+		 *		    In the parallel mode, individuals are evaluated with this function directly instead of splitting the population.
+		 * \param fitness 
+		 */
+		void set_individual_fitness(individual_fitness_fnc_type fitness)
+		{
+			this->individual_fitness_ = fitness;
+		}
+
+		/**
+		 * \brief Configures how many threads evaluate the fitness function.
+		 * \remarks Fitness functions must be safe to call concurrently if more than one thread is used.
+		 *		    Results do not depend on the number of threads.
+		 * \param threads Number of threads. 0 or 1 means that the fitness is evaluated on the calling thread.
+		 */
+		void set_fitness_threads(const size_t threads)
+		{
+			fitness_pool_ = threads > 1 ? std::make_shared<ThreadPool>(threads) : nullptr;
+		}
+
+		/**
+		 * \brief The thread pool that evaluates the fitness function, nullptr if it is evaluated on the calling thread.
+		 *		  Operators can share it instead of starting threads of their own, as they never run during the evaluation.
+		 *		  set_fitness_threads replaces the pool, but operators keep the pool they were given.
+		 * \return
+		 */
+		std::shared_ptr<ThreadPool> fitness_pool() const
+		{
+			return fitness_pool_;
+		}
+
+		/**
+		 * \brief Configures how many runs of evolve_batch are executed concurrently.
+		 * \remarks Operators, selectors and fitness functions are copied for every thread.
+		 *		    The population initializer must be safe to call concurrently if more than one thread is used.
+		 * \param threads Number of threads. 0 or 1 means that runs are executed one after another.
+		 */
+		void set_batch_threads(const size_t threads)
+		{
+			batch_threads_ = threads;
+		}
+
+		/**
+		 * \brief Sets the master seed from which random streams of individual runs are derived.
+		 * \remarks Runs of evolve_batch are reproducible for a given seed, no matter how many batch threads are used.
+		 *		    If no seed is set, a random one is picked for each batch.
+		 * \param seed 
+		 */
+		void set_seed(const uint64_t seed)
+		{
+			seed_set_ = true;
+			seed_ = seed;
+		}
+
+		/**
+		 * \brief Sets a function that is called with the duration of every stage of every generation.
+		 * \remarks Stages are timed with std::chrono::steady_clock only if an observer is set.
+		 *		    Runs of evolve_batch executed on batch threads share the observer, so it must be thread-safe in that case.
+		 * \param observer Observer or an empty function to stop timing
+		 */
+		void set_stage_observer(stage_observer_type observer)
+		{
+			stage_observer_ = std::move(observer);
+		}
+
+		/**
+		 * \brief Sets a function that receives the instrumentation counters after every generation.
+		 * \remarks Counters are compiled in only if EA_INSTRUMENTATION is defined, otherwise all values are zero.
+		 *		    Use PrometheusTextSink to export them to a file.
+		 * \param sink Sink or an empty function to stop reporting
+		 */
+		void set_counter_sink(counter_sink_type sink)
+		{
+			counter_sink_ = std::move(sink);
+			counted_generations_ = 0;
+			last_counters_ = collect_counters();
+		}
+
 		/**
 		 * \brief Configures elitism.
 		 * \param percentage What percentage of the best individuals should be kept.
@@ -120,6 +592,158 @@ namespace ea
 			elitism_percentage_ = percentage;
 		}
 
+		/**
+		 * \brief Sets whether a smaller (default) or a bigger objective value is better. Used by the objective stop conditions.
+		 * \param direction
+		 */
+		void set_objective_direction(const ObjectiveDirection direction)
+		{
+			objective_direction_ = direction;
+		}
+
+		/**
+		 * \brief Stops a run when the objective reaches a bound that cannot be improved, e.g. a lower bound of a minimized objective.
+		 * \param bound
+		 */
+		void set_objective_bound(const fitness_value_type bound)
+		{
+			objective_bound_set_ = true;
+			objective_bound_ = bound;
+		}
+
+		/**
+		 * \brief Stops a run when the objective of the best individual is at least as good as a given target.
+		 * \param target
+		 */
+		void set_target_objective(const fitness_value_type target)
+		{
+			target_objective_set_ = true;
+			target_objective_ = target;
+		}
+
+		/**
+		 * \brief Stops a run when the best fitness has not improved for a given number of generations.
+		 * \param generations 0 disables the condition
+		 */
+		void set_stagnation_limit(const size_t generations)
+		{
+			stagnation_limit_ = generations;
+		}
+
+		/**
+		 * \brief Stops a run when the fitness function was evaluated for a given number of individuals.
+		 * \remarks The condition is checked after every generation, so the last generation can exceed the limit.
+		 * \param evaluations 0 disables the condition
+		 */
+		void set_max_evaluations(const size_t evaluations)
+		{
+			max_evaluations_ = evaluations;
+		}
+
+		/**
+		 * \brief Stops a run when it takes longer than a given time. The condition is checked after every generation.
+		 * \param limit Zero disables the condition
+		 */
+		void set_time_limit(const std::chrono::steady_clock::duration limit)
+		{
+			time_limit_ = limit;
+		}
+
+		/**
+		 * \brief Adds a custom condition that is checked after every generation. The run stops when it returns true.
+		 * \param condition
+		 */
+		void add_stop_condition(stop_condition_type condition)
+		{
+			stop_conditions_.push_back(std::move(condition));
+		}
+
+		/**
+		 * \brief Sends the progress of runs to a logger instead of the output stream of evolve.
+		 *		  The logger formats the records on its own thread, so the output does not slow down the run.
+		 * \param logger nullptr writes the progress to the output stream
+		 */
+		void set_progress_logger(std::shared_ptr<ProgressLogger> logger)
+		{
+			progress_logger_ = std::move(logger);
+		}
+
+		/**
+		 * \brief Sets the control through which other threads cancel runs, set their deadline and read the best individual found so far.
+		 * \param control nullptr disables the control
+		 */
+		void set_run_control(std::shared_ptr<run_control_type> control)
+		{
+			run_control_ = std::move(control);
+		}
+
+		/**
+		 * \brief The run control or nullptr if none is set.
+		 * \return
+		 */
+		const std::shared_ptr<run_control_type> & run_control() const
+		{
+			return run_control_;
+		}
+
+		/**
+		 * \brief Enables checkpoints of runs. A checkpoint is written after every given number of generations, after a given time
+		 *		  and when a run stops. Checkpoints are written on a background thread.
+		 * \remarks The checkpoint of a run is stored to "<path>.<index of the run>". evolve_batch continues every run
+		 *		    that has a checkpoint instead of starting it again, with the seed the run was started with.
+		 * \param path Path prefix of the checkpoint files
+		 * \param generations Every how many generations is a checkpoint written, 0 disables the condition
+		 * \param interval Minimal time between checkpoints, zero disables the condition
+		 */
+		void set_checkpointing(const std::string & path, const size_t generations, const std::chrono::steady_clock::duration interval)
+		{
+			checkpoint_path_ = path;
+			checkpoint_generations_ = generations;
+			checkpoint_interval_ = interval;
+
+			if (!checkpoint_writer_)
+			{
+				checkpoint_writer_ = std::make_shared<CheckpointWriter>();
+			}
+		}
+
+		/**
+		 * \brief Path of the checkpoint of a given run.
+		 * \param run
+		 * \return
+		 */
+		std::string checkpoint_path(const size_t run) const
+		{
+			return checkpoint_path_ + "." + std::to_string(run);
+		}
+
+		/**
+		 * \brief Summary of the last run of evolve(population, generations).
+		 * \return
+		 */
+		const RunResult & run_result() const
+		{
+			return run_result_;
+		}
+
+		/**
+		 * \brief Number of fitness evaluations since the start of the last run, including generations evolved by evolve(population, next_pop).
+		 * \return
+		 */
+		size_t evaluations() const
+		{
+			return evaluations_;
+		}
+
+		/**
+		 * \brief Summaries of the runs of the last evolve_batch, in the order of runs.
+		 * \return
+		 */
+		const std::vector<RunResult> & batch_results() const
+		{
+			return batch_results_;
+		}
+
 		/**
 		 * \brief Sets te objective function.
 		 * \param objective 
@@ -147,6 +771,130 @@ namespace ea
 			output_frequency_ = frequency;
 		}
 
+		/**
+		 * \brief Computes the objective value of a given individual.
+		 * \remarks The fitness value is returned if no objective function is set.
+		 * \param individual 
+		 * \return 
+		 */
+		fitness_value_type objective(individual_type & individual) const
+		{
+			return objective_fnc_ ? objective_fnc_(individual) : individual.fitness;
+		}
+
+		/**
+		 * \brief Updates the fitness of all individuals in the population.
+		 * \remarks If more than one fitness thread is configured, the population is processed by the thread pool.
+		 *		    Individuals are evaluated one by one if an individual fitness function is set. Without the thread pool,
+		 *		    a population fitness function is preferred unless a run control is set. Otherwise the population
+		 *		    is split into chunks (a single chunk without the thread pool) that are evaluated by the population fitness function.
+		 *		    The run control is checked before every individual, or before every chunk, and if it asks the run to stop,
+		 *		    the remaining ones are not evaluated. Only evaluated individuals are added to the number of evaluations.
+		 * \param population 
+		 * \return False if the evaluation was interrupted by the run control. The population must be discarded then.
+		 */
+		bool evaluate(TPopulation & population)
+		{
+			if (!fitness_pool_ || population.size() < 2)
+			{
+				// A population fitness function evaluates all individuals without checking the run control
+				if (!individual_fitness_ || (fitness_ && !run_control_))
+				{
+					if (stop_requested())
+					{
+						return false;
+					}
+
+					fitness_(population);
+					count_evaluations(population.size());
+
+					return true;
+				}
+
+				for (size_t i = 0; i < population.size(); ++i)
+				{
+					if (stop_requested())
+					{
+						count_evaluations(i);
+						return false;
+					}
+
+					individual_fitness_(population[i]);
+				}
+
+				count_evaluations(population.size());
+
+				return true;
+			}
+
+			// Set by the threads that stop early, a later check of the run control could already see a moved deadline
+			std::atomic<bool> interrupted{ false };
+			std::atomic<size_t> evaluated{ 0 };
+
+			if (individual_fitness_)
+			{
+				fitness_pool_->parallel_for(population.size(), [&](const size_t begin, const size_t end) {
+					for (auto i = begin; i < end; ++i)
+					{
+						if (stop_requested())
+						{
+							interrupted = true;
+							evaluated += i - begin;
+							return;
+						}
+
+						individual_fitness_(population[i]);
+					}
+
+					evaluated += end - begin;
+				});
+
+				count_evaluations(evaluated);
+
+				return !interrupted;
+			}
+
+			// Move individuals to one sub-population per thread and move them back when they are evaluated
+			const auto chunks_count = (std::min)(fitness_pool_->size(), population.size());
+			std::vector<TPopulation> chunks(chunks_count);
+
+			for (size_t chunk = 0; chunk < chunks_count; ++chunk)
+			{
+				for (auto i = chunk * population.size() / chunks_count; i < (chunk + 1) * population.size() / chunks_count; ++i)
+				{
+					chunks[chunk].push_back(std::move(population[i]));
+				}
+			}
+
+			fitness_pool_->parallel_for(chunks_count, [&](const size_t begin, const size_t end) {
+				for (auto chunk = begin; chunk < end; ++chunk)
+				{
+					if (stop_requested())
+					{
+						interrupted = true;
+						return;
+					}
+
+					fitness_(chunks[chunk]);
+					evaluated += chunks[chunk].size();
+				}
+			});
+
+			size_t position = 0;
+
+			for (auto && chunk : chunks)
+			{
+				for (auto && individual : chunk)
+				{
+					population[position++] = std::move(individual);
+				}
+			}
+
+			count_evaluations(evaluated);
+
+			return !interrupted;
+		}
+
 		/**
 		 * \brief Does one iteration of the evolutionary algorithm.
 		 * \param population 
@@ -155,39 +903,91 @@ namespace ea
 		TPopulation evolve(const TPopulation & population)
 		{
 			TPopulation new_pop{};
+			evolve(population, new_pop);
+
+			return new_pop;
+		}
+
+		/**
+		 * \brief Does one iteration of the evolutionary algorithm and stores the next generation to a given population.
+		 * \remarks Offspring are created in a buffer that is kept between generations. With a population type that keeps
+		 *		    its individuals when cleared (e.g. RecyclingPopulation), no heap allocations are made once the buffers are warm.
+		 *		    If the run control asks the run to stop, the generation is abandoned between stages or during the fitness evaluation.
+		 * \param population The current generation
+		 * \param next_pop Population that is overwritten with the next generation. Must not be the same object as population.
+		 * \return False if the generation was abandoned. next_pop must not be used then.
+		 */
+		bool evolve(const TPopulation & population, TPopulation & next_pop)
+		{
+			using clock = std::chrono::steady_clock;
+
+			const auto timed = static_cast<bool>(stage_observer_);
+			const auto generation_start = timed ? clock::now() : clock::time_point{};
+			auto stage_start = generation_start;
+
+			// Reports the time since the end of the previous stage
+			const auto end_stage = [&](const Stage stage, const size_t index) {
+				if (timed)
+				{
+					const auto now = clock::now();
+					stage_observer_(stage, index, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - stage_start).count()));
+					stage_start = now;
+				}
+			};
+
+			if (stop_requested())
+			{
+				return false;
+			}
+
+			offspring_.clear();
 
 			// Apply mating selectors
 			for (size_t i = 0; i < mating_selectors_.size(); ++i)
 			{
-				mating_selectors_[i](population, new_pop, how_many_should_select(i, mating_selectors_.size(), population.size()));
+				mating_selectors_[i](population, offspring_, how_many_should_select(i, mating_selectors_.size(), population.size()));
 			}
 
+			end_stage(Stage::mating_selection, 0);
+
 			// Apply operators
-			for (auto&& op : operators_)
+			for (size_t i = 0; i < operators_.size(); ++i)
 			{
-				op(new_pop);
+				if (stop_requested())
+				{
+					return false;
+				}
+
+				operators_[i](offspring_);
+				end_stage(Stage::operation, i);
 			}
 
 			// Apply the fitness function
-			fitness_(new_pop);
+			if (!evaluate(offspring_))
+			{
+				return false;
+			}
+
+			end_stage(Stage::fitness, 0);
 
-			auto temp = std::move(new_pop);
 			auto select_count = population.size();
-			new_pop = TPopulation{};
+			next_pop.clear();
 
 			// Apply elitism if enabled
 			if (elitism_enabled_)
 			{
-				auto population_copy = population;
-				std::sort(population_copy.begin(), population_copy.end(), [](auto i1, auto i2) { return i1.fitness > i2.fitness; });
-				const auto elite_count = static_cast<int>(std::ceil(population_copy.size() * elitism_percentage_));
+				const auto elite_count = static_cast<size_t>(std::ceil(population.size() * elitism_percentage_));
+				select_elites(population, elite_count, elite_candidates_);
 
-				for (auto i = 0; i < elite_count; ++i)
+				for (size_t i = 0; i < elite_count; ++i)
 				{
-					new_pop.push_back(population_copy[i]);
+					next_pop.push_back(population[elite_candidates_[i].second]);
 				}
 
+				EA_COUNT(bytes_copied, elite_count == 0 ? 0 : elite_count * genome_bytes(population[0]));
+
 				select_count -= elite_count;
+				end_stage(Stage::elitism, 0);
 			}
 
 			// Apply natural selectors if we have any
@@ -195,7 +995,7 @@ namespace ea
 			{
 				for (size_t i = 0; i < natural_selectors_.size(); ++i)
 				{
-					natural_selectors_[i](temp, new_pop, how_many_should_select(i, natural_selectors_.size(), select_count));
+					natural_selectors_[i](offspring_, next_pop, how_many_should_select(i, natural_selectors_.size(), select_count));
 				}
 			}
 			// Or just pick the best individuals if there is no natural selector
@@ -203,11 +1003,47 @@ namespace ea
 			{
 				for (size_t i = 0; i < select_count; ++i)
 				{
-					new_pop.push_back(temp[i]);
+					next_pop.push_back(offspring_[i]);
 				}
+
+				EA_COUNT(bytes_copied, select_count == 0 ? 0 : select_count * genome_bytes(offspring_[0]));
 			}
 
-			return new_pop;
+			best_index_ = find_best_index(next_pop);
+			end_stage(Stage::natural_selection, 0);
+
+			if (counter_sink_)
+			{
+				report_counters();
+			}
+
+			if (timed)
+			{
+				stage_observer_(Stage::generation, 0, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stage_start - generation_start).count()));
+			}
+
+			return true;
+		}
+
+		/**
+		 * \brief Index of the best individual in the population that was created by the last call of evolve.
+		 * \return 
+		 */
+		size_t best_index() const
+		{
+			return best_index_;
+		}
+
+		/**
+		 * \brief Checks the stop conditions after a generation that was evolved by evolve(population, next_pop), e.g. by an island.
+		 * \param population The population created by the generation
+		 * \param progress Progress of the run. The objective of its best individual is updated.
+		 * \param reason Set to the reason of the stop
+		 * \return Whether the run should stop
+		 */
+		bool stop_reached(TPopulation & population, RunProgress<fitness_value_type> & progress, StopReason & reason)
+		{
+			return should_stop(population[best_index_], progress, reason);
 		}
 
 		/**
@@ -218,45 +1054,109 @@ namespace ea
 		 */
 		individual_type evolve(TPopulation population, const size_t generations)
 		{
-			for (size_t i = 0; i < generations; ++i)
+			return evolve(std::move(population), generations, std::cout);
+		}
+
+		/**
+		 * \brief Evolve the population for a given number of generations or until a stop condition is met.
+		 * \remarks Every generation draws from its own stream of the random generator of the current thread (see rng_generation).
+		 *		    Why the run stopped is available in run_result(). The run also stops when the run control asks it to,
+		 *		    in that case the generation in progress is discarded.
+		 * \param population The initial population
+		 * \param generations The maximum number of generations
+		 * \param out Stream to which the progress is written
+		 * \return The best individual
+		 */
+		individual_type evolve(TPopulation population, const size_t generations, std::ostream & out)
+		{
+			CheckpointState<fitness_value_type> state;
+			state.seed = rng_gen().seed();
+			state.stream = rng_gen().id();
+
+			return run(std::move(population), state, generations, out);
+		}
+
+		/**
+		 * \brief Continues a run from a checkpoint. The population is not evaluated again and the random generator
+		 *		  of the current thread is moved to the stream of the run, so the run continues exactly as if it was not interrupted.
+		 * \param path Path of the checkpoint
+		 * \param generations The maximum number of generations, including those evolved before the checkpoint
+		 * \param out Stream to which the progress is written
+		 * \return The best individual
+		 */
+		individual_type resume(const std::string & path, const size_t generations, std::ostream & out)
+		{
+			CheckpointState<fitness_value_type> state;
+			auto population = load_checkpoint<TPopulation>(path, state);
+
+			rng_seed(state.seed, state.stream);
+			rng_gen().discard(state.rng_position);
+			best_index_ = find_best_index(population);
+
+			return run(std::move(population), state, generations, out);
+		}
+
+		/**
+		 * \brief Evolves the population until a given deadline, a stop condition or a cancellation through the run control.
+		 *		  The deadline of the run control is restored when the run returns. If no run control is set, one is used
+		 *		  only for this run.
+		 * \param population The initial population
+		 * \param deadline
+		 * \return The best individual of the last completed generation
+		 */
+		individual_type evolve_until(TPopulation population, const std::chrono::steady_clock::time_point deadline)
+		{
+			return evolve_until(std::move(population), deadline, std::cout);
+		}
+
+		/**
+		 * \brief Evolves the population until a given deadline, a stop condition or a cancellation through the run control.
+		 *		  The deadline of the run control is restored when the run returns. If no run control is set, one is used
+		 *		  only for this run.
+		 * \param population The initial population
+		 * \param deadline
+		 * \param out Stream to which the progress is written
+		 * \return The best individual of the last completed generation
+		 */
+		individual_type evolve_until(TPopulation population, const std::chrono::steady_clock::time_point deadline, std::ostream & out)
+		{
+			// Restores the run control even if the run throws, so that later runs neither stop at the deadline
+			// nor compare their individuals with the best one published by this run
+			struct RunControlRestorer
 			{
-				population = evolve(population);
+				std::shared_ptr<run_control_type> & control;
+				std::shared_ptr<run_control_type> previous;
+				std::chrono::steady_clock::time_point previous_deadline;
 
-				// Output progress
-				if (output_frequency_ != 0 && i % output_frequency_ == 0)
+				~RunControlRestorer()
 				{
-					auto & best = get_best_individual(population);
-					auto objective = objective_fnc_ ? objective_fnc_(best) : best.fitness;
-
-					std::cout << "gen: " << i << "; obj: " << objective;
-					
-					if (individual_to_string_)
+					if (previous)
 					{
-						std::cout << "; best ind.: " << individual_to_string_(best);
+						previous->set_deadline(previous_deadline);
 					}
-					
-					std::cout << std::endl;
+
+					control = std::move(previous);
 				}
-			}
+			};
 
-			// Output total results
-			auto & total_best = get_best_individual(population);
-			auto total_objective = objective_fnc_ ? objective_fnc_(total_best) : total_best.fitness;
-			std::cout << "<< FINISHED >> best obj: " << total_objective;
+			RunControlRestorer restorer{ run_control_, run_control_, run_control_ ? run_control_->deadline() : (std::chrono::steady_clock::time_point::max)() };
 
-			if (individual_to_string_)
+			if (!run_control_)
 			{
-				std::cout << "; best ind.: " << individual_to_string_(total_best);
+				run_control_ = std::make_shared<run_control_type>();
 			}
 
-			std::cout << std::endl;
+			run_control_->set_deadline(deadline);
 
-			// Return the best individual
-			return total_best;
+			return evolve(std::move(population), (std::numeric_limits<size_t>::max)(), out);
 		}
 
 		/**
 		 * \brief Does multiple runs of the algorithm.
+		 * \remarks Every run uses its own random streams that are keyed by the master seed and the index of the run.
+		 *		    Runs that have a checkpoint are continued from it (see set_checkpointing).
+		 *		    If more than one batch thread is configured, runs are executed concurrently.
+		 *		    The output of each run is then buffered and printed in the order of runs.
 		 * \param generations How many generations should we evolve in each run
 		 * \param runs How many runs
 		 * \param population_initializer Function that creates the initial population for each run
@@ -265,21 +1165,89 @@ namespace ea
 		std::vector<individual_type> evolve_batch(const size_t generations, const size_t runs, population_initializer_type population_initializer)
 		{
 			std::vector<individual_type> results{};
+			std::vector<RunResult> run_results(runs);
+			const auto master_seed = seed_set_ ? seed_ : (static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}();
+			const auto threads_count = (std::min)(batch_threads_, runs);
 
-			for (size_t i = 0; i < runs; ++i)
+			if (threads_count <= 1)
+			{
+				for (size_t i = 0; i < runs; ++i)
+				{
+					auto best_individual = evolve_run(i, master_seed, generations, population_initializer, std::cout);
+					results.push_back(best_individual);
+					run_results[i] = run_result_;
+				}
+			}
+			else
 			{
-				auto initial_pop = population_initializer();
-				auto best_individual = evolve(initial_pop, generations);
-				results.push_back(best_individual);
+				std::vector<std::promise<individual_type>> promises(runs);
+				std::vector<std::string> outputs(runs);
+				std::vector<std::thread> threads;
+				std::atomic<size_t> next_run{ 0 };
+
+				for (size_t t = 0; t < threads_count; ++t)
+				{
+					// Every thread works with its own copy of the algorithm so that stateful operators are not shared
+					threads.emplace_back([&, worker_ea = *this]() mutable {
+						for (auto i = next_run++; i < runs; i = next_run++)
+						{
+							try
+							{
+								std::ostringstream out;
+								auto best_individual = worker_ea.evolve_run(i, master_seed, generations, population_initializer, out);
+								outputs[i] = out.str();
+								run_results[i] = worker_ea.run_result();
+								promises[i].set_value(best_individual);
+							}
+							catch (...)
+							{
+								promises[i].set_exception(std::current_exception());
+							}
+						}
+					});
+				}
+
+				std::exception_ptr exception;
+
+				for (size_t i = 0; i < runs; ++i)
+				{
+					try
+					{
+						results.push_back(promises[i].get_future().get());
+						std::cout << outputs[i] << std::flush;
+					}
+					catch (...)
+					{
+						exception = std::current_exception();
+						break;
+					}
+				}
+
+				if (exception)
+				{
+					// Do not start any new runs and wait for the running ones
+					next_run = runs;
+				}
+
+				for (auto && thread : threads)
+				{
+					thread.join();
+				}
+
+				if (exception)
+				{
+					std::rethrow_exception(exception);
+				}
 			}
 
+			batch_results_ = run_results;
 			std::cout << "<<< Results >>>" << std::endl;
 
 			for (size_t i = 0; i < runs; ++i)
 			{
 				auto & best = results[i];
-				auto best_objective = objective_fnc_ ? objective_fnc_(best) : best.fitness;
-				std::cout << "<< Run " << i << " >> best obj: " << best_objective;
+				auto best_objective = objective(best);
+				std::cout << "<< Run " << i << " >> best obj: " << best_objective << "; generations: " << run_results[i].generations << "; stopped: " << stop_reason_name(run_results[i].reason);
 
 				if (individual_to_string_)
 				{
@@ -0,0 +1,251 @@
+#ifndef CONTIGUOUSINDIVIDUAL_H
+#define CONTIGUOUSINDIVIDUAL_H
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Utils/BlockSwap.h"
+
+namespace ea
+{
+	/**
+	 * \brief Individual of ContiguousPopulation. It is either a view of a row of the population or an owning copy of one.
+	 *		  Copies of views (e.g. the best individual returned by the algorithm) own their elements.
+	 *		  Assigning to a view writes the elements and the fitness into the population.
+	 * \tparam TElement Type of elements
+	 * \tparam TFitness Type of the fitness value
+	 * \remarks The fitness is a reference to the packed fitness array of the population (or to the own value of an owning individual).
+	 *		    Views are valid until the population grows beyond its capacity or is destroyed.
+	 */
+	template<typename TElement, typename TFitness>
+	class ContiguousIndividual
+	{
+		static_assert(!std::is_same<TElement, bool>::value, "std::vector<bool> is not contiguous, use uint8_t elements instead");
+
+		std::vector<TElement> storage_;
+		TFitness own_fitness_{};
+		TElement * elements_;
+		size_t size_;
+		bool owning_;
+
+		/**
+		 * \brief Copies given elements into the individual. Views must keep their size.
+		 * \param elements
+		 * \param size
+		 */
+		void assign(const TElement * elements, const size_t size)
+		{
+			if (owning_)
+			{
+				storage_.assign(elements, elements + size);
+				elements_ = storage_.data();
+				size_ = size;
+			}
+			else
+			{
+				if (size != size_)
+					throw std::invalid_argument("All individuals of a contiguous population must have the same size");
+
+				std::copy(elements, elements + size, elements_);
+			}
+		}
+
+	public:
+		using element_type = TElement;
+		using fitness_type = TFitness;
+		using container_type = std::vector<TElement>;
+
+		TFitness & fitness;
+
+		/**
+		 * \brief Construct an owning individual with a given container.
+		 * \param container
+		 */
+		explicit ContiguousIndividual(container_type && container)
+			: storage_(std::move(container)), elements_(storage_.data()), size_(storage_.size()), owning_(true), fitness(own_fitness_)
+		{
+			/* empty */
+		}
+
+		/**
+		 * \brief Constructs a view of a row of a population. Used by ContiguousPopulation.
+		 * \param elements
+		 * \param size
+		 * \param fitness
+		 */
+		ContiguousIndividual(TElement * elements, const size_t size, TFitness & fitness)
+			: elements_(elements), size_(size), owning_(false), fitness(fitness)
+		{
+			/* empty */
+		}
+
+		/**
+		 * \brief Creates an owning copy of a given individual.
+		 * \param other
+		 */
+		ContiguousIndividual(const ContiguousIndividual & other)
+			: storage_(other.begin(), other.end()), own_fitness_(other.fitness), elements_(storage_.data()), size_(other.size_), owning_(true), fitness(own_fitness_)
+		{
+			/* empty */
+		}
+
+		/**
+		 * \brief Creates an owning individual. Elements of an owning individual are moved, elements of a view are copied.
+		 * \param other
+		 */
+		ContiguousIndividual(ContiguousIndividual && other)
+			: storage_(other.owning_ ? std::move(other.storage_) : container_type(other.begin(), other.end())), own_fitness_(other.fitness),
+			elements_(storage_.data()), size_(storage_.size()), owning_(true), fitness(own_fitness_)
+		{
+			if (other.owning_)
+			{
+				other.elements_ = other.storage_.data();
+				other.size_ = other.storage_.size();
+			}
+		}
+
+		/**
+		 * \brief Copies elements and the fitness of a given individual.
+		 * \param other
+		 * \return
+		 */
+		ContiguousIndividual & operator=(const ContiguousIndividual & other)
+		{
+			if (this != &other)
+			{
+				assign(other.elements_, other.size_);
+				fitness = other.fitness;
+			}
+
+			return *this;
+		}
+
+		/**
+		 * \brief Moves elements if both individuals own them, copies them otherwise.
+		 * \param other
+		 * \return
+		 */
+		ContiguousIndividual & operator=(ContiguousIndividual && other)
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+
+			if (owning_ && other.owning_)
+			{
+				storage_.swap(other.storage_);
+				elements_ = storage_.data();
+				size_ = storage_.size();
+				other.elements_ = other.storage_.data();
+				other.size_ = other.storage_.size();
+			}
+			else
+			{
+				assign(other.elements_, other.size_);
+			}
+
+			fitness = other.fitness;
+
+			return *this;
+		}
+
+		/**
+		 * \brief Whether the individual is a view of a row of a population.
+		 * \return
+		 */
+		bool is_view() const
+		{
+			return !owning_;
+		}
+
+		/**
+		 * \brief Operatror[] on the elements.
+		 * \param index
+		 * \return
+		 */
+		TElement & operator[](const size_t index)
+		{
+			return elements_[index];
+		}
+
+		/**
+		 * \brief Operatror[] on the elements.
+		 * \param index
+		 * \return
+		 */
+		const TElement & operator[](const size_t index) const
+		{
+			return elements_[index];
+		}
+
+		/**
+		 * \brief Sets the value of a given element.
+		 * \param index
+		 * \param value
+		 */
+		void set(const size_t index, const TElement & value)
+		{
+			elements_[index] = value;
+		}
+
+		/**
+		 * \brief Swaps elements in the range [begin, end) with elements of another individual.
+		 * \param other
+		 * \param begin
+		 * \param end
+		 */
+		void swap_range(ContiguousIndividual & other, const size_t begin, const size_t end)
+		{
+			if (begin < end)
+			{
+				swap_arrays(elements_ + begin, other.elements_ + begin, end - begin);
+			}
+		}
+
+		/**
+		 * \brief Swaps elements whose bits in a given mask are set with elements of another individual.
+		 * \param other
+		 * \param mask Bit i of the word (i / 64) belongs to the element i. Must have at least (size() + 63) / 64 words.
+		 */
+		void swap_masked(ContiguousIndividual & other, const uint64_t * mask)
+		{
+			for_each_set_bit(size_, mask, [&](const size_t index)
+			{
+				std::swap(elements_[index], other.elements_[index]);
+			});
+		}
+
+		/**
+		 * \brief Number of elements
+		 * \return
+		 */
+		size_t size() const
+		{
+			return size_;
+		}
+
+		TElement * begin()
+		{
+			return elements_;
+		}
+
+		TElement * end()
+		{
+			return elements_ + size_;
+		}
+
+		const TElement * begin() const
+		{
+			return elements_;
+		}
+
+		const TElement * end() const
+		{
+			return elements_ + size_;
+		}
+	};
+}
+#endif // CONTIGUOUSINDIVIDUAL_H
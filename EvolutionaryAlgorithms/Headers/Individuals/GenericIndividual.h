@@ -1,5 +1,9 @@
 ﻿#ifndef GENERICINDIVIDUAL_H
 #define GENERICINDIVIDUAL_H
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include "Utils/BlockSwap.h"
 
 namespace ea
 {
@@ -36,6 +40,50 @@ namespace ea
 			return container_[index];
 		}
 
+		/**
+		 * \brief Operatror[] on the container.
+		 * \param index 
+		 * \return 
+		 */
+		const element_type & operator[](const size_t index) const
+		{
+			return container_[index];
+		}
+
+		/**
+		 * \brief Sets the value of a given element.
+		 * \remarks Operators should change elements with this method (or swap_range) so that
+		 *		    derived individuals can keep data computed from the elements up to date.
+		 * \param index 
+		 * \param value 
+		 */
+		void set(const size_t index, const element_type & value)
+		{
+			container_[index] = value;
+		}
+
+		/**
+		 * \brief Swaps elements in the range [begin, end) with elements of another individual.
+		 *		  Contiguous containers of trivially copyable elements are swapped in blocks.
+		 * \param other 
+		 * \param begin 
+		 * \param end 
+		 */
+		void swap_range(GenericIndividual & other, const size_t begin, const size_t end)
+		{
+			swap_container_ranges(container_, other.container_, begin, end);
+		}
+
+		/**
+		 * \brief Swaps elements whose bits in a given mask are set with elements of another individual.
+		 * \param other 
+		 * \param mask Bit i of the word (i / 64) belongs to the element i. Must have at least (size() + 63) / 64 words.
+		 */
+		void swap_masked(GenericIndividual & other, const uint64_t * mask)
+		{
+			swap_container_masked(container_, other.container_, container_.size(), mask);
+		}
+
 		/**
 		 * \brief Size of the container
 		 * \return 
@@ -63,6 +111,24 @@ namespace ea
 		{
 			return std::end(container_);
 		}
+
+		/**
+		 * \brief Gets the begin iterator of the container
+		 * \return 
+		 */
+		typename TContainer::const_iterator begin() const
+		{
+			return std::begin(container_);
+		}
+
+		/**
+		 * \brief Gets the end iterator of the container.
+		 * \return 
+		 */
+		typename TContainer::const_iterator end() const
+		{
+			return std::end(container_);
+		}
 	};
 
 }
@@ -0,0 +1,196 @@
+#ifndef PACKEDBITINDIVIDUAL_H
+#define PACKEDBITINDIVIDUAL_H
+#include <cstdint>
+#include <vector>
+
+namespace ea
+{
+	/**
+	 * \brief Individual that consists of bits that are packed to 64-bit words.
+	 *		  Range and masked swaps used by crossovers and BitFlipMutation work with whole words instead of individual bits.
+	 * \tparam TFitness Type of the fitness value
+	 * \remarks Bits beyond size() in the last word are always zero.
+	 */
+	template<typename TFitness>
+	class PackedBitIndividual
+	{
+		std::vector<uint64_t> words_;
+		size_t size_;
+
+	public:
+		using element_type = bool;
+		using fitness_type = TFitness;
+		using word_type = uint64_t;
+
+		static const size_t word_bits = 64;
+
+		TFitness fitness{};
+
+		/**
+		 * \brief Construct the individual with a given number of bits that are all set to zero.
+		 * \param size
+		 */
+		explicit PackedBitIndividual(const size_t size) : words_((size + word_bits - 1) / word_bits, 0), size_(size) {}
+
+		/**
+		 * \brief Gets the value of a given bit.
+		 * \param index
+		 * \return
+		 */
+		bool operator[](const size_t index) const
+		{
+			return ((words_[index / word_bits] >> (index % word_bits)) & 1) != 0;
+		}
+
+		/**
+		 * \brief Sets the value of a given bit.
+		 * \param index
+		 * \param value
+		 */
+		void set(const size_t index, const bool value)
+		{
+			const auto mask = uint64_t{ 1 } << (index % word_bits);
+
+			if (value)
+			{
+				words_[index / word_bits] |= mask;
+			}
+			else
+			{
+				words_[index / word_bits] &= ~mask;
+			}
+		}
+
+		/**
+		 * \brief Flips the value of a given bit.
+		 * \param index
+		 */
+		void flip(const size_t index)
+		{
+			words_[index / word_bits] ^= uint64_t{ 1 } << (index % word_bits);
+		}
+
+		/**
+		 * \brief Swaps bits in the range [begin, end) with bits of another individual.
+		 *		  Whole words are swapped and the words at the ends of the range are spliced with masks.
+		 * \param other 
+		 * \param begin 
+		 * \param end 
+		 */
+		void swap_range(PackedBitIndividual & other, const size_t begin, const size_t end)
+		{
+			if (begin >= end)
+			{
+				return;
+			}
+
+			const auto first_word = begin / word_bits;
+			const auto last_word = (end - 1) / word_bits;
+			const auto first_mask = ~uint64_t{ 0 } << (begin % word_bits);
+			const auto last_mask = end % word_bits == 0 ? ~uint64_t{ 0 } : (uint64_t{ 1 } << (end % word_bits)) - 1;
+
+			if (first_word == last_word)
+			{
+				swap_word_bits(other, first_word, first_mask & last_mask);
+				return;
+			}
+
+			swap_word_bits(other, first_word, first_mask);
+
+			for (auto i = first_word + 1; i < last_word; ++i)
+			{
+				const auto temp = words_[i];
+				words_[i] = other.words_[i];
+				other.words_[i] = temp;
+			}
+
+			swap_word_bits(other, last_word, last_mask);
+		}
+
+		/**
+		 * \brief Swaps bits whose bits in a given mask are set with bits of another individual.
+		 * \param other 
+		 * \param mask Bit i of the word (i / 64) belongs to the bit i. Must have at least word_count() words.
+		 */
+		void swap_masked(PackedBitIndividual & other, const uint64_t * mask)
+		{
+			for (size_t i = 0; i < words_.size(); ++i)
+			{
+				swap_word_bits(other, i, mask[i]);
+			}
+		}
+
+		/**
+		 * \brief Swaps bits of a given word that are set in a mask with another individual.
+		 * \param other 
+		 * \param index 
+		 * \param mask 
+		 */
+		void swap_word_bits(PackedBitIndividual & other, const size_t index, const uint64_t mask)
+		{
+			const auto difference = (words_[index] ^ other.words_[index]) & mask;
+			words_[index] ^= difference;
+			other.words_[index] ^= difference;
+		}
+
+		/**
+		 * \brief Number of bits
+		 * \return
+		 */
+		size_t size() const
+		{
+			return size_;
+		}
+
+		/**
+		 * \brief Number of words
+		 * \return
+		 */
+		size_t word_count() const
+		{
+			return words_.size();
+		}
+
+		/**
+		 * \brief Gets a given word. Bit i of the individual is stored in the bit (i % 64) of the word (i / 64).
+		 * \param index
+		 * \return
+		 */
+		uint64_t & word(const size_t index)
+		{
+			return words_[index];
+		}
+
+		/**
+		 * \brief Gets a given word.
+		 * \param index
+		 * \return
+		 */
+		uint64_t word(const size_t index) const
+		{
+			return words_[index];
+		}
+
+		/**
+		 * \brief Mask of bits of the last word that belong to the individual.
+		 * \return
+		 */
+		uint64_t last_word_mask() const
+		{
+			return size_ % word_bits == 0 ? ~uint64_t{ 0 } : (uint64_t{ 1 } << (size_ % word_bits)) - 1;
+		}
+	};
+
+	/**
+	 * \brief Number of bytes that are copied with the genome of a given individual (see Utils/Instrumentation.h).
+	 * \tparam TFitness
+	 * \param individual
+	 * \return
+	 */
+	template<typename TFitness>
+	size_t genome_bytes(const PackedBitIndividual<TFitness> & individual)
+	{
+		return individual.word_count() * sizeof(uint64_t);
+	}
+}
+#endif // PACKEDBITINDIVIDUAL_H
@@ -0,0 +1,156 @@
+#ifndef SHAREDGENOMEINDIVIDUAL_H
+#define SHAREDGENOMEINDIVIDUAL_H
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include "Utils/BlockSwap.h"
+
+namespace ea
+{
+	/**
+	 * \brief Individual whose copies share the container until one of them is changed (copy-on-write).
+	 *		  Selectors then copy only a pointer and the container is cloned on the first write to a selected individual.
+	 * \tparam TContainer Type of the used container
+	 * \tparam TFitness Type of the fitness value
+	 * \remarks Elements can be changed only with set, swap_range and swap_masked, direct access is read-only.
+	 *		    A shared container is cloned by the first of these calls that changes it.
+	 */
+	template<typename TContainer, typename TFitness>
+	class SharedGenomeIndividual
+	{
+		std::shared_ptr<TContainer> container_;
+
+		/**
+		 * \brief Clones the container if it is shared with another individual.
+		 * \return The container owned only by this individual
+		 */
+		TContainer & unique_container()
+		{
+			if (container_.use_count() > 1)
+			{
+				container_ = std::make_shared<TContainer>(*container_);
+			}
+
+			return *container_;
+		}
+
+	public:
+		using element_type = typename TContainer::value_type;
+		using fitness_type = TFitness;
+		using container_type = TContainer;
+
+		TFitness fitness{};
+
+		/**
+		 * \brief Construct the individual with a given container.
+		 * \param container
+		 */
+		explicit SharedGenomeIndividual(TContainer && container) : container_(std::make_shared<TContainer>(std::move(container))) {}
+
+		/**
+		 * \brief Operatror[] on the container.
+		 * \param index
+		 * \return
+		 */
+		const element_type & operator[](const size_t index) const
+		{
+			return (*container_)[index];
+		}
+
+		/**
+		 * \brief Sets the value of a given element. The container is not cloned if the value does not change.
+		 * \param index
+		 * \param value
+		 */
+		void set(const size_t index, const element_type & value)
+		{
+			if ((*container_)[index] != value)
+			{
+				unique_container()[index] = value;
+			}
+		}
+
+		/**
+		 * \brief Swaps elements in the range [begin, end) with elements of another individual.
+		 *		  Nothing is cloned if the range is empty or both individuals share the container.
+		 * \param other
+		 * \param begin
+		 * \param end
+		 */
+		void swap_range(SharedGenomeIndividual & other, const size_t begin, const size_t end)
+		{
+			if (begin >= end || container_ == other.container_)
+			{
+				return;
+			}
+
+			swap_container_ranges(unique_container(), other.unique_container(), begin, end);
+		}
+
+		/**
+		 * \brief Swaps elements whose bits in a given mask are set with elements of another individual.
+		 *		  Nothing is cloned if both individuals share the container.
+		 * \param other
+		 * \param mask Bit i of the word (i / 64) belongs to the element i. Must have at least (size() + 63) / 64 words.
+		 */
+		void swap_masked(SharedGenomeIndividual & other, const uint64_t * mask)
+		{
+			if (container_ == other.container_)
+			{
+				return;
+			}
+
+			swap_container_masked(unique_container(), other.unique_container(), size(), mask);
+		}
+
+		/**
+		 * \brief Whether the container is shared with another individual.
+		 * \return
+		 */
+		bool is_shared() const
+		{
+			return container_.use_count() > 1;
+		}
+
+		/**
+		 * \brief Size of the container
+		 * \return
+		 */
+		size_t size() const
+		{
+			return container_->size();
+		}
+
+		/**
+		 * \brief Gets the begin iterator of the container
+		 * \return
+		 */
+		typename TContainer::const_iterator begin() const
+		{
+			return std::begin(static_cast<const TContainer &>(*container_));
+		}
+
+		/**
+		 * \brief Gets the end iterator of the container.
+		 * \return
+		 */
+		typename TContainer::const_iterator end() const
+		{
+			return std::end(static_cast<const TContainer &>(*container_));
+		}
+	};
+
+	/**
+	 * \brief Number of bytes that are copied with the genome of a given individual (see Utils/Instrumentation.h).
+	 *		  Copies share the container, so no elements are copied.
+	 * \tparam TContainer
+	 * \tparam TFitness
+	 * \return
+	 */
+	template<typename TContainer, typename TFitness>
+	size_t genome_bytes(const SharedGenomeIndividual<TContainer, TFitness> &)
+	{
+		return 0;
+	}
+}
+#endif // SHAREDGENOMEINDIVIDUAL_H
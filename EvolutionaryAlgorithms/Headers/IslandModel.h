@@ -0,0 +1,342 @@
+#ifndef ISLANDMODEL_H
+#define ISLANDMODEL_H
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "EvolutionaryAlgorithm.h"
+#include "Utils/Mailbox.h"
+#include "Utils/Utils.h"
+
+namespace ea
+{
+	/**
+	 * \brief How islands are connected when individuals migrate.
+	 */
+	enum class MigrationTopology
+	{
+		ring, // Each island sends migrants to the next island
+		fully_connected, // Each island sends migrants to all other islands
+		random // Each island sends migrants to a randomly chosen island
+	};
+
+	/**
+	 * \brief Island model - evolves multiple sub-populations, each on its own thread, and periodically exchanges their best individuals.
+	 * \tparam TPopulation Type of the population.
+	 * \remarks Every island is driven by its own EvolutionaryAlgorithm, so islands can use different operators and selectors.
+	 *		    Migrants are exchanged through lock-free mailboxes, islands never wait for each other.
+	 *		    Each island checks the stop conditions of its algorithm after every generation. When one island reaches
+	 *		    the objective bound or the target objective, all islands stop and report that reason.
+	 */
+	template<typename TPopulation>
+	class IslandModel
+	{
+		using algorithm_type = EvolutionaryAlgorithm<TPopulation>;
+		using individual_type = typename TPopulation::value_type;
+		using fitness_value_type = typename individual_type::fitness_type;
+		using population_initializer_type = std::function<TPopulation()>;
+
+		struct Island
+		{
+			algorithm_type algorithm;
+			population_initializer_type population_initializer;
+		};
+
+		std::vector<Island> islands_;
+
+		size_t migration_interval_ = 50;
+		size_t migrants_count_ = 1;
+		MigrationTopology topology_ = MigrationTopology::ring;
+
+		bool seed_set_ = false;
+		uint64_t seed_ = 0;
+
+		std::vector<RunResult> island_results_;
+
+		/**
+		 * \brief Returns indices of individuals sorted from the best to the worst.
+		 * \param population
+		 * \return
+		 */
+		static std::vector<size_t> rank(const TPopulation & population)
+		{
+			std::vector<size_t> indices(population.size());
+			std::iota(indices.begin(), indices.end(), 0);
+			std::stable_sort(indices.begin(), indices.end(), [&](const size_t i1, const size_t i2) { return population[i1].fitness > population[i2].fitness; });
+
+			return indices;
+		}
+
+		/**
+		 * \brief Computes the islands that receive migrants from a given island.
+		 * \param island
+		 * \return
+		 */
+		std::vector<size_t> get_targets(const size_t island) const
+		{
+			std::vector<size_t> targets;
+
+			if (islands_.size() < 2)
+			{
+				return targets;
+			}
+
+			switch (topology_)
+			{
+			case MigrationTopology::ring:
+				targets.push_back((island + 1) % islands_.size());
+				break;
+
+			case MigrationTopology::fully_connected:
+				for (size_t i = 0; i < islands_.size(); ++i)
+				{
+					if (i != island)
+					{
+						targets.push_back(i);
+					}
+				}
+				break;
+
+			case MigrationTopology::random:
+				{
+					std::uniform_int_distribution<size_t> int_distribution(0, islands_.size() - 2);
+					const auto target = int_distribution(rng_gen());
+					targets.push_back(target >= island ? target + 1 : target);
+				}
+				break;
+			}
+
+			return targets;
+		}
+
+		/**
+		 * \brief Evolves a single island. Runs on its own thread.
+		 * \param island
+		 * \param generations
+		 * \param mailboxes
+		 * \param model_stop Reason why all islands stop, StopReason::generations while no island reached the objective bound or target
+		 * \param result Set to the summary of the island's run
+		 * \return The best individual of the island
+		 */
+		individual_type evolve_island(const size_t island, const size_t generations, std::vector<Mailbox<std::vector<individual_type>>> & mailboxes,
+			std::atomic<StopReason> & model_stop, RunResult & result)
+		{
+			using clock = std::chrono::steady_clock;
+
+			auto & algorithm = islands_[island].algorithm;
+			auto population = islands_[island].population_initializer();
+			TPopulation next_pop{};
+
+			const auto start = clock::now();
+			const auto start_evaluations = algorithm.evaluations();
+			RunProgress<fitness_value_type> progress{ 0, 0, 0, fitness_value_type{}, clock::duration{ 0 } };
+			fitness_value_type best_fitness{};
+
+			for (size_t i = 0; i < generations; ++i)
+			{
+				const auto model_reason = model_stop.load(std::memory_order_relaxed);
+
+				if (model_reason != StopReason::generations)
+				{
+					result.reason = model_reason;
+					break;
+				}
+
+				rng_generation(i + 1);
+
+				// The run control of the algorithm abandoned the generation
+				if (!algorithm.evolve(population, next_pop))
+				{
+					result.reason = algorithm.run_control()->cancel_requested() ? StopReason::cancelled : StopReason::deadline;
+					break;
+				}
+
+				std::swap(population, next_pop);
+
+				const auto & best = population[algorithm.best_index()];
+
+				if (i == 0 || best_fitness < best.fitness)
+				{
+					best_fitness = best.fitness;
+					progress.stagnant_generations = 0;
+				}
+				else
+				{
+					++progress.stagnant_generations;
+				}
+
+				progress.generation = i + 1;
+				progress.evaluations = algorithm.evaluations() - start_evaluations;
+				progress.elapsed = clock::now() - start;
+				result.generations = i + 1;
+
+				if (algorithm.stop_reached(population, progress, result.reason))
+				{
+					// Other islands cannot find a better objective, so they stop too
+					if (result.reason == StopReason::optimum || result.reason == StopReason::target_objective)
+					{
+						auto expected = StopReason::generations;
+						model_stop.compare_exchange_strong(expected, result.reason, std::memory_order_relaxed);
+					}
+
+					break;
+				}
+
+				if (migration_interval_ == 0 || (i + 1) % migration_interval_ != 0)
+				{
+					continue;
+				}
+
+				// Send copies of the best individuals
+				auto ranks = rank(population);
+				const auto migrants_count = (std::min)(migrants_count_, population.size());
+				std::vector<individual_type> migrants;
+
+				for (size_t j = 0; j < migrants_count; ++j)
+				{
+					migrants.push_back(population[ranks[j]]);
+				}
+
+				for (auto && target : get_targets(island))
+				{
+					mailboxes[target].post(migrants);
+				}
+
+				// Replace the worst individuals with immigrants that arrived so far
+				auto worst = ranks.rbegin();
+
+				for (auto && message : mailboxes[island].take_all())
+				{
+					for (auto && immigrant : message)
+					{
+						if (worst == ranks.rend())
+						{
+							break;
+						}
+
+						population[*worst++] = std::move(immigrant);
+					}
+				}
+			}
+
+			result.evaluations = algorithm.evaluations() - start_evaluations;
+
+			return population[rank(population)[0]];
+		}
+
+	public:
+		/**
+		 * \brief Adds an island.
+		 * \param algorithm Configured algorithm that evolves the island.
+		 * \param population_initializer Function that creates the initial population of the island.
+		 */
+		void add_island(algorithm_type algorithm, population_initializer_type population_initializer)
+		{
+			islands_.push_back(Island{ std::move(algorithm), std::move(population_initializer) });
+		}
+
+		/**
+		 * \brief Configures the migration.
+		 * \param interval Every how many generations do islands exchange individuals. 0 disables the migration.
+		 * \param migrants_count How many of the best individuals are sent to each target island.
+		 * \param topology
+		 */
+		void set_migration(const size_t interval, const size_t migrants_count, const MigrationTopology topology)
+		{
+			migration_interval_ = interval;
+			migrants_count_ = migrants_count;
+			topology_ = topology;
+		}
+
+		/**
+		 * \brief Sets the master seed from which random streams of individual islands are derived.
+		 * \param seed
+		 */
+		void set_seed(const uint64_t seed)
+		{
+			seed_set_ = true;
+			seed_ = seed;
+		}
+
+		/**
+		 * \brief Summaries of the islands of the last evolve, in the order of islands.
+		 * \return
+		 */
+		const std::vector<RunResult> & island_results() const
+		{
+			return island_results_;
+		}
+
+		/**
+		 * \brief Evolves all islands for a given number of generations or until their stop conditions are met.
+		 * \remarks Every island draws from random streams keyed by the master seed, the run and the index of the island.
+		 *		    The islands exchange migrants asynchronously, so their results also depend on the timing of the threads.
+		 *		    Why each island stopped is available in island_results().
+		 * \param generations How many generations should each island evolve
+		 * \param run Index of the run, so that repeated runs with the same seed use different random streams
+		 * \return The best individual of each island
+		 */
+		std::vector<individual_type> evolve(const size_t generations, const size_t run = 0)
+		{
+			if (islands_.empty())
+				throw std::logic_error{ "At least one island must be added." };
+
+			const auto master_seed = seed_set_ ? seed_ : (static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}();
+			std::vector<Mailbox<std::vector<individual_type>>> mailboxes(islands_.size());
+			std::vector<std::vector<individual_type>> results(islands_.size());
+			std::vector<std::exception_ptr> exceptions(islands_.size());
+			std::vector<RunResult> island_results(islands_.size());
+			std::atomic<StopReason> model_stop{ StopReason::generations };
+			std::vector<std::thread> threads;
+
+			for (size_t island = 0; island < islands_.size(); ++island)
+			{
+				threads.emplace_back([&, island]() {
+					try
+					{
+						rng_seed(master_seed, StreamId{ run, island });
+						results[island].push_back(evolve_island(island, generations, mailboxes, model_stop, island_results[island]));
+					}
+					catch (...)
+					{
+						exceptions[island] = std::current_exception();
+					}
+				});
+			}
+
+			for (auto && thread : threads)
+			{
+				thread.join();
+			}
+
+			island_results_ = island_results;
+			std::vector<individual_type> best_individuals;
+
+			for (size_t island = 0; island < islands_.size(); ++island)
+			{
+				if (exceptions[island])
+				{
+					std::rethrow_exception(exceptions[island]);
+				}
+
+				best_individuals.push_back(results[island][0]);
+			}
+
+			for (size_t island = 0; island < islands_.size(); ++island)
+			{
+				std::cout << "<< Island " << island << " >> best obj: " << islands_[island].algorithm.objective(best_individuals[island])
+					<< "; generations: " << island_results_[island].generations << "; stopped: " << stop_reason_name(island_results_[island].reason) << std::endl;
+			}
+
+			return best_individuals;
+		}
+	};
+}
+#endif // ISLANDMODEL_H
@@ -1,6 +1,13 @@
 ﻿#ifndef BITFLIPMUTATION_H
 #define BITFLIPMUTATION_H
+#include <cmath>
+#include <cstdint>
 #include <random>
+#include <vector>
+#include "Individuals/PackedBitIndividual.h"
+#include "Operators/GeneSampling.h"
+#include "Utils/Instrumentation.h"
+#include "Utils/Utils.h"
 
 namespace ea
 {
@@ -11,37 +18,165 @@ namespace ea
 	template<typename TPopulation>
 	class BitFlipMutation
 	{
-		std::uniform_real_distribution<> real_dist_;
+		using individual_type = typename TPopulation::value_type;
+
 		double bit_mutation_probability_;
+		GeneSampling sampling_;
+		SkipSampler skip_sampler_;
+
+		// Binary digits of the probability, starting with the least significant one that is set
+		std::vector<bool> probability_digits_;
+		bool flip_all_ = false;
+
+		// Whether packed individuals use skip sampling because the probability is below the precision of random masks
+		bool skip_packed_ = false;
+
+		// Uniform numbers drawn in bulk, kept between calls
+		std::vector<double> uniforms_;
+
+		/**
+		 * \brief Flips each bit with the given probability.
+		 * \tparam TIndividual
+		 * \param individual
+		 */
+		template<typename TIndividual>
+		void mutate(TIndividual & individual)
+		{
+			if (sampling_ == GeneSampling::skip)
+			{
+				skip_sampler_.for_each(individual.size(), [&](const size_t position) {
+					individual.set(position, !individual[position]);
+					EA_COUNT(mutations, 1);
+				});
+				return;
+			}
+
+			uniforms_.resize(individual.size());
+			rng_gen().fill_uniform(uniforms_.data(), uniforms_.size());
+
+			for (size_t i = 0; i < individual.size(); ++i)
+			{
+				if (uniforms_[i] < bit_mutation_probability_)
+				{
+					individual.set(i, !individual[i]);
+					EA_COUNT(mutations, 1);
+				}
+			}
+		}
+
+		/**
+		 * \brief Flips bits of whole words by XORing them with random masks.
+		 * \tparam TFitness
+		 * \param individual
+		 */
+		template<typename TFitness>
+		void mutate(PackedBitIndividual<TFitness> & individual)
+		{
+			if (sampling_ == GeneSampling::skip || skip_packed_)
+			{
+				skip_sampler_.for_each(individual.size(), [&](const size_t position) {
+					individual.flip(position);
+					EA_COUNT(mutations, 1);
+				});
+				return;
+			}
+
+			if (probability_digits_.empty() && !flip_all_)
+			{
+				return;
+			}
+
+			for (size_t i = 0; i < individual.word_count(); ++i)
+			{
+				auto mask = flip_all_ ? ~uint64_t{ 0 } : random_mask();
+
+				if (i == individual.word_count() - 1)
+				{
+					mask &= individual.last_word_mask();
+				}
+
+				individual.word(i) ^= mask;
+				EA_COUNT(mutations, popcount(mask));
+			}
+		}
+
+		/**
+		 * \brief Creates a random word where each bit is set with the mutation probability.
+		 * \remarks Random words are combined from the least significant binary digit of the probability.
+		 *		    A digit 1 adds a random half of the unset bits (OR) and a digit 0 keeps a random half of the set bits (AND).
+		 * \return
+		 */
+		uint64_t random_mask() const
+		{
+			uint64_t mask = 0;
+
+			for (auto && digit : probability_digits_)
+			{
+				mask = digit ? (mask | rng_word()) : (mask & rng_word());
+			}
+
+			return mask;
+		}
 
 	public:
 		/**
-		 * \brief 
+		 * \brief
 		 * \param bit_mutation_probability Probability of flipping a bit
+		 * \param sampling How are flipped bits chosen. Skip sampling is faster for low probabilities.
 		 */
-		explicit BitFlipMutation(const double bit_mutation_probability) : bit_mutation_probability_(bit_mutation_probability)
+		explicit BitFlipMutation(const double bit_mutation_probability, const GeneSampling sampling = GeneSampling::per_gene)
+			: bit_mutation_probability_(bit_mutation_probability), sampling_(sampling)
 		{
 			if (bit_mutation_probability < 0 || bit_mutation_probability > 1)
 				throw std::invalid_argument("mutation_probability must be from the interval [0,1]");
 
-			real_dist_ = std::uniform_real_distribution<>(0, 1);
+			skip_sampler_ = SkipSampler(bit_mutation_probability);
+
+			// The probability is represented with the precision of 2^-32 in packed individuals
+			const auto precision_digits = 32;
+			auto scaled = static_cast<uint64_t>(std::round(std::ldexp(bit_mutation_probability, precision_digits)));
+			flip_all_ = scaled >> precision_digits != 0;
+
+			// Lower nonzero probabilities would round to never flipping a bit
+			skip_packed_ = scaled == 0 && bit_mutation_probability > 0;
+
+			if (scaled == 0 || flip_all_)
+			{
+				return;
+			}
+
+			auto digits = precision_digits;
+
+			while ((scaled & 1) == 0)
+			{
+				scaled >>= 1;
+				--digits;
+			}
+
+			for (; digits > 0; --digits, scaled >>= 1)
+			{
+				probability_digits_.push_back((scaled & 1) != 0);
+			}
 		}
-		
+
+		/**
+		 * \brief For each bit of a given individual, we check if it should be flipped and if so, we flip it.
+		 * \param individual
+		 */
+		void apply(individual_type & individual)
+		{
+			mutate(individual);
+		}
+
 		/**
 		* \brief For each bit in every individual, we check if it should be flipped and if so, we flip it.
 		* \param population The population that is changed by the operator.
 		*/
-		void operator()(TPopulation& population) 
+		void operator()(TPopulation& population)
 		{
 			for (auto&& individual : population)
 			{
-				for (auto&& element : individual)
-				{
-					if (real_dist_(rng_gen()) < bit_mutation_probability_)
-					{
-						element = !element;
-					}
-				}
+				mutate(individual);
 			}
 		}
 	};
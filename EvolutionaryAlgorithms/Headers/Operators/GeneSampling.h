@@ -0,0 +1,93 @@
+#ifndef GENESAMPLING_H
+#define GENESAMPLING_H
+#include <random>
+#include <stdexcept>
+#include "Utils/Utils.h"
+
+namespace ea
+{
+	/**
+	 * \brief How mutation operators choose genes that are changed.
+	 */
+	enum class GeneSampling
+	{
+		per_gene, // One random number is drawn for every gene
+		skip // Gaps between changed genes are drawn from the geometric distribution
+	};
+
+	/**
+	 * \brief Picks positions that are selected independently with a given probability
+	 *		  by sampling the gap to the next selected position from the geometric distribution.
+	 * \remarks The distribution of selected positions is the same as when each position is checked separately,
+	 *		    but the number of random numbers drawn is proportional to the number of selected positions.
+	 */
+	class SkipSampler
+	{
+		double probability_;
+		std::geometric_distribution<size_t> gap_dist_;
+
+	public:
+		/**
+		 * \brief Creates a sampler that never selects any position.
+		 */
+		SkipSampler() : SkipSampler(0) {}
+
+		/**
+		 * \brief
+		 * \param probability Probability of selecting each position
+		 */
+		explicit SkipSampler(const double probability) : probability_(probability)
+		{
+			if (probability < 0 || probability > 1)
+				throw std::invalid_argument("probability must be from the interval [0,1]");
+
+			if (probability > 0 && probability < 1)
+			{
+				gap_dist_ = std::geometric_distribution<size_t>(probability);
+			}
+		}
+
+		/**
+		 * \brief Calls a given function for each selected position in [0, length).
+		 * \tparam TFunction
+		 * \param length
+		 * \param function Function that is called with the position
+		 */
+		template<typename TFunction>
+		void for_each(const size_t length, TFunction function)
+		{
+			if (probability_ == 0)
+			{
+				return;
+			}
+
+			if (probability_ == 1)
+			{
+				for (size_t position = 0; position < length; ++position)
+				{
+					function(position);
+				}
+
+				return;
+			}
+
+			auto position = gap_dist_(rng_gen());
+
+			while (position < length)
+			{
+				function(position);
+
+				// Compare before adding so that very long gaps cannot overflow
+				const auto gap = gap_dist_(rng_gen());
+
+				if (gap >= length - position - 1)
+				{
+					break;
+				}
+
+				position += gap + 1;
+			}
+		}
+	};
+}
+#endif // GENESAMPLING_H
@@ -1,26 +1,67 @@
 ﻿#ifndef INTEGERMUTATION_H
 #define INTEGERMUTATION_H
 #include <cstdint>
+#include <limits>
 #include <random>
+#include <stdexcept>
+#include <vector>
+#include "Operators/GeneSampling.h"
+#include "Utils/Instrumentation.h"
 #include "Utils/Utils.h"
 
 namespace ea
 {
 	/**
 	* \brief Class implementing the Uniform integer mutation
-	* \tparam TPopulation Type of the population
+	* \tparam TPopulation Type of the population. Elements of individuals can be narrower than int (e.g. uint8_t) if they hold the whole range.
 	*/
 	template<typename TPopulation>
 	class IntegerMutation
 	{
+		using individual_type = typename TPopulation::value_type;
+		using element_type = typename individual_type::element_type;
+
 		int_least32_t from_;
 		int_least32_t to_;
 		double mutation_probability_;
 		double gene_change_probability_;
+		GeneSampling sampling_;
+		SkipSampler skip_sampler_;
 
-		std::uniform_real_distribution<> real_dist_;
 		std::uniform_int_distribution<> int_dist_;
 
+		// Uniform numbers drawn in bulk, kept between calls
+		std::vector<double> individual_uniforms_;
+		std::vector<double> gene_uniforms_;
+
+		/**
+		 * \brief Mutates each gene of a given individual with the gene change probability.
+		 * \param individual
+		 */
+		void mutate_genes(individual_type & individual)
+		{
+			if (sampling_ == GeneSampling::skip)
+			{
+				skip_sampler_.for_each(individual.size(), [&](const size_t position) {
+					individual.set(position, static_cast<element_type>(int_dist_(rng_gen())));
+					EA_COUNT(mutations, 1);
+				});
+				return;
+			}
+
+			gene_uniforms_.resize(individual.size());
+			rng_gen().fill_uniform(gene_uniforms_.data(), gene_uniforms_.size());
+
+			for (size_t i = 0; i < individual.size(); ++i)
+			{
+				if (gene_uniforms_[i] < gene_change_probability_)
+				{
+					individual.set(i, static_cast<element_type>(int_dist_(rng_gen())));
+					EA_COUNT(mutations, 1);
+				}
+			}
+		}
+
 	public:
 		/**
 		 * \brief 
@@ -28,21 +69,38 @@ namespace ea
 		 * \param to The upper bound of the mutation. Inclusive.
 		 * \param mutation_probability The probability of mutating an individual.
 		 * \param gene_change_probability The probability of mutating an individual gene value.
+		 * \param sampling How are mutated genes chosen. Skip sampling is faster for low gene change probabilities.
 		 */
-		IntegerMutation(const int_least32_t from, const int_least32_t to, const double mutation_probability, const double gene_change_probability)
-			: from_(from), to_(to), mutation_probability_(mutation_probability), gene_change_probability_(gene_change_probability)
+		IntegerMutation(const int_least32_t from, const int_least32_t to, const double mutation_probability, const double gene_change_probability, const GeneSampling sampling = GeneSampling::per_gene)
+			: from_(from), to_(to), mutation_probability_(mutation_probability), gene_change_probability_(gene_change_probability),
+			  sampling_(sampling)
 		{
 			if (from > to)
 				throw std::invalid_argument("from must be less than or equal to to");
 
+			if (from < (std::numeric_limits<element_type>::min)() || to > (std::numeric_limits<element_type>::max)())
+				throw std::invalid_argument("Elements of individuals cannot hold values from the interval [from,to]");
+
 			if (mutation_probability < 0 || mutation_probability > 1)
 				throw std::invalid_argument("mutation_probability must be from the interval [0,1]");
 
 			if (gene_change_probability < 0 || gene_change_probability > 1)
 				throw std::invalid_argument("gene_change_probability must be from the interval [0,1]");
 
-			real_dist_ = std::uniform_real_distribution<>(0, 1);
 			int_dist_ = std::uniform_int_distribution<>(from, to);
+			skip_sampler_ = SkipSampler(gene_change_probability);
+		}
+
+		/**
+		 * \brief Checks if a given individual should be mutated and if so, repeats the process for every gene value, mutating chosen ones.
+		 * \param individual
+		 */
+		void apply(individual_type & individual)
+		{
+			if (rng_gen().uniform() < mutation_probability_)
+			{
+				mutate_genes(individual);
+			}
 		}
 
 		/**
@@ -51,17 +109,15 @@ namespace ea
 		*/
 		void operator()(TPopulation& population)
 		{
+			individual_uniforms_.resize(population.size());
+			rng_gen().fill_uniform(individual_uniforms_.data(), individual_uniforms_.size());
+			size_t index = 0;
+
 			for (auto && individual : population)
 			{
-				if (real_dist_(rng_gen()) < mutation_probability_)
+				if (individual_uniforms_[index++] < mutation_probability_)
 				{
-					for (auto && element : individual)
-					{
-						if (real_dist_(rng_gen()) < gene_change_probability_)
-						{
-							element = int_dist_(rng_gen());
-						}
-					}
+					mutate_genes(individual);
 				}
 			}
 		}
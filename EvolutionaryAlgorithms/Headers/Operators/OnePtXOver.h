@@ -1,6 +1,7 @@
 ﻿#ifndef ONEPTXOVER_H
 #define ONEPTXOVER_H
 #include <random>
+#include "Utils/Instrumentation.h"
 #include "Utils/Utils.h"
 
 namespace ea
@@ -13,6 +14,8 @@ namespace ea
 	template<typename TPopulation>
 	class OnePtXOver
 	{
+		using individual_type = typename TPopulation::value_type;
+
 		double probability_;
 		std::uniform_real_distribution<> real_dist_;
 
@@ -26,6 +29,23 @@ namespace ea
 			real_dist_ = std::uniform_real_distribution<>(0, 1);
 		}
 
+		/**
+		 * \brief Rolls a dice to decide if we should do the crossover of a given pair of individuals.
+		 *		  If so, we pick a random position in the individuals and switch all data beyond that position.
+		 * \param p1
+		 * \param p2
+		 */
+		void apply(individual_type & p1, individual_type & p2)
+		{
+			if (real_dist_(rng_gen()) < probability_)
+			{
+				EA_COUNT(crossovers, 1);
+				std::uniform_int_distribution<int> int_distribution(0, p1.size() - 1);
+				const auto position = int_distribution(rng_gen());
+				p1.swap_range(p2, position, p1.size());
+			}
+		}
+
 		/**
 		 * \brief For each consecutive pair of individuals rolls a dice to decide if we should do the crossover.
 		 *		  If so, we pick a random position in the individuls and switch all data beyond that position.
@@ -33,25 +53,9 @@ namespace ea
 		 */
 		void operator()(TPopulation& population)
 		{
-			auto individual_size = population[0].size();
-			const std::uniform_int_distribution<int> int_distribution(0, individual_size - 1);
-
 			for (size_t i = 0; i < population.size() / 2; ++i)
 			{
-				auto p1 = population[2 * i];
-				auto p2 = population[2 * i + 1];
-
-				if (real_dist_(rng_gen()) < probability_)
-				{
-					const auto position = int_distribution(rng_gen());
-
-					for (size_t pos = position; pos < individual_size; ++pos)
-					{
-						auto temp = p1[pos];
-						p1[pos] = p2[pos];
-						p2[pos] = temp;
-					}
-				}
+				apply(population[2 * i], population[2 * i + 1]);
 			}
 		}
 	};
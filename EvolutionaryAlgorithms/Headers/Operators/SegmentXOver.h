@@ -0,0 +1,81 @@
+#ifndef SEGMENTXOVER_H
+#define SEGMENTXOVER_H
+#include <random>
+#include <stdexcept>
+#include "Utils/Instrumentation.h"
+#include "Utils/Utils.h"
+
+namespace ea
+{
+	/**
+	* \brief Class implementing the Segment crossover operator that switches a segment of a given length.
+	*		 Segments that reach beyond the end of individuals continue from the start.
+	* \tparam TPopulation Type of the population
+	*/
+	template<typename TPopulation>
+	class SegmentXOver
+	{
+		using individual_type = typename TPopulation::value_type;
+
+		double probability_;
+		size_t segment_length_;
+		std::uniform_real_distribution<> real_dist_;
+
+	public:
+		/**
+		 * \brief 
+		 * \param probability The probability of doing the crossover for each pair of individuals
+		 * \param segment_length Number of elements in the switched segment. Longer segments switch whole individuals.
+		 */
+		SegmentXOver(const double probability, const size_t segment_length) : probability_(probability), segment_length_(segment_length)
+		{
+			if (segment_length == 0)
+				throw std::invalid_argument("segment_length must be positive");
+
+			real_dist_ = std::uniform_real_distribution<>(0, 1);
+		}
+
+		/**
+		 * \brief Rolls a dice to decide if we should do the crossover of a given pair of individuals.
+		 *		  If so, we pick a random start position and switch the segment that begins there.
+		 * \param p1
+		 * \param p2
+		 */
+		void apply(individual_type & p1, individual_type & p2)
+		{
+			if (real_dist_(rng_gen()) < probability_)
+			{
+				EA_COUNT(crossovers, 1);
+				const auto individual_size = p1.size();
+				const auto length = segment_length_ < individual_size ? segment_length_ : individual_size;
+				std::uniform_int_distribution<size_t> int_distribution(0, individual_size - 1);
+				const auto begin = int_distribution(rng_gen());
+
+				if (begin + length <= individual_size)
+				{
+					p1.swap_range(p2, begin, begin + length);
+				}
+				else
+				{
+					p1.swap_range(p2, begin, individual_size);
+					p1.swap_range(p2, 0, begin + length - individual_size);
+				}
+			}
+		}
+
+		/**
+		 * \brief For each consecutive pair of individuals rolls a dice to decide if we should do the crossover.
+		 *		  If so, we pick a random start position and switch the segment that begins there.
+		 *		  Individuals are changed in place.
+		 * \param population The population that is changed by the operator.
+		 */
+		void operator()(TPopulation& population)
+		{
+			for (size_t i = 0; i < population.size() / 2; ++i)
+			{
+				apply(population[2 * i], population[2 * i + 1]);
+			}
+		}
+	};
+}
+#endif // SEGMENTXOVER_H
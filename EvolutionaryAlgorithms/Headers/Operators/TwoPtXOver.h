@@ -0,0 +1,72 @@
+#ifndef TWOPTXOVER_H
+#define TWOPTXOVER_H
+#include <random>
+#include <utility>
+#include "Utils/Instrumentation.h"
+#include "Utils/Utils.h"
+
+namespace ea
+{
+	/**
+	* \brief Class implementing the Two point crossover operator
+	* \tparam TPopulation Type of the population
+	* \remarks https://en.wikipedia.org/wiki/Crossover_(genetic_algorithm)
+	*/
+	template<typename TPopulation>
+	class TwoPtXOver
+	{
+		using individual_type = typename TPopulation::value_type;
+
+		double probability_;
+		std::uniform_real_distribution<> real_dist_;
+
+	public:
+		/**
+		 * \brief 
+		 * \param probability The probability of doing the crossover for each pair of individuals
+		 */
+		explicit TwoPtXOver(const double probability) : probability_(probability)
+		{
+			real_dist_ = std::uniform_real_distribution<>(0, 1);
+		}
+
+		/**
+		 * \brief Rolls a dice to decide if we should do the crossover of a given pair of individuals.
+		 *		  If so, we pick two random positions in the individuals and switch all data between them.
+		 * \param p1
+		 * \param p2
+		 */
+		void apply(individual_type & p1, individual_type & p2)
+		{
+			if (real_dist_(rng_gen()) < probability_)
+			{
+				EA_COUNT(crossovers, 1);
+				std::uniform_int_distribution<size_t> int_distribution(0, p1.size());
+				auto begin = int_distribution(rng_gen());
+				auto end = int_distribution(rng_gen());
+
+				if (begin > end)
+				{
+					std::swap(begin, end);
+				}
+
+				p1.swap_range(p2, begin, end);
+			}
+		}
+
+		/**
+		 * \brief For each consecutive pair of individuals rolls a dice to decide if we should do the crossover.
+		 *		  If so, we pick two random positions in the individuals and switch all data between them.
+		 *		  Individuals are changed in place.
+		 * \param population The population that is changed by the operator.
+		 */
+		void operator()(TPopulation& population)
+		{
+			for (size_t i = 0; i < population.size() / 2; ++i)
+			{
+				apply(population[2 * i], population[2 * i + 1]);
+			}
+		}
+	};
+}
+#endif // TWOPTXOVER_H
@@ -0,0 +1,72 @@
+#ifndef UNIFORMXOVER_H
+#define UNIFORMXOVER_H
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Utils/Instrumentation.h"
+#include "Utils/Utils.h"
+
+namespace ea
+{
+	/**
+	* \brief Class implementing the Uniform crossover operator
+	* \tparam TPopulation Type of the population
+	* \remarks https://en.wikipedia.org/wiki/Crossover_(genetic_algorithm)
+	*/
+	template<typename TPopulation>
+	class UniformXOver
+	{
+		using individual_type = typename TPopulation::value_type;
+
+		double probability_;
+		std::uniform_real_distribution<> real_dist_;
+		std::vector<uint64_t> mask_;
+
+	public:
+		/**
+		 * \brief 
+		 * \param probability The probability of doing the crossover for each pair of individuals
+		 */
+		explicit UniformXOver(const double probability) : probability_(probability)
+		{
+			real_dist_ = std::uniform_real_distribution<>(0, 1);
+		}
+
+		/**
+		 * \brief Rolls a dice to decide if we should do the crossover of a given pair of individuals.
+		 *		  If so, each element is switched with the probability 0.5.
+		 * \param p1
+		 * \param p2
+		 */
+		void apply(individual_type & p1, individual_type & p2)
+		{
+			if (real_dist_(rng_gen()) < probability_)
+			{
+				EA_COUNT(crossovers, 1);
+				mask_.resize((p1.size() + 63) / 64);
+
+				for (auto && word : mask_)
+				{
+					word = rng_word();
+				}
+
+				p1.swap_masked(p2, mask_.data());
+			}
+		}
+
+		/**
+		 * \brief For each consecutive pair of individuals rolls a dice to decide if we should do the crossover.
+		 *		  If so, each element is switched with the probability 0.5.
+		 *		  Switched elements are chosen by a mask of random words, so one random number is drawn for every 64 elements.
+		 * \param population The population that is changed by the operator.
+		 */
+		void operator()(TPopulation& population)
+		{
+			for (size_t i = 0; i < population.size() / 2; ++i)
+			{
+				apply(population[2 * i], population[2 * i + 1]);
+			}
+		}
+	};
+}
+#endif // UNIFORMXOVER_H
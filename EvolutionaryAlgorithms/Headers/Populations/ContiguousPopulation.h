@@ -0,0 +1,274 @@
+#ifndef CONTIGUOUSPOPULATION_H
+#define CONTIGUOUSPOPULATION_H
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Individuals/ContiguousIndividual.h"
+
+namespace ea
+{
+	/**
+	 * \brief Population that stores all genomes in one row-major buffer with a fixed stride and fitness values in a separate packed array.
+	 *		  Individuals are exposed as views (ContiguousIndividual), so operators, selectors and fitness functions written
+	 *		  for other individuals work on it unchanged, while sweeps over the population read memory sequentially.
+	 * \tparam TElement Type of elements of genomes
+	 * \tparam TFitness Type of the fitness value
+	 * \remarks All individuals must have the same size, which is set by the first added individual.
+	 *		    Like RecyclingPopulation, clear keeps the storage, so a population of a stable size does not allocate.
+	 */
+	template<typename TElement, typename TFitness>
+	class ContiguousPopulation
+	{
+		std::vector<TElement> elements_;
+		std::vector<TFitness> fitness_;
+		std::vector<ContiguousIndividual<TElement, TFitness>> views_;
+		size_t stride_ = 0;
+		size_t size_ = 0;
+
+		/**
+		 * \brief Makes sure there is a row for one more individual. Views are created again if the buffers move.
+		 */
+		void grow()
+		{
+			if (size_ < views_.size())
+			{
+				return;
+			}
+
+			const auto capacity = views_.empty() ? 1 : 2 * views_.size();
+			reserve(capacity);
+		}
+
+		/**
+		 * \brief Sets the stride if the population is empty, otherwise checks that a given size matches it.
+		 * \param size
+		 */
+		void check_size(const size_t size)
+		{
+			if (size_ == 0 && size != stride_)
+			{
+				const auto capacity = views_.size();
+				stride_ = size;
+				views_.clear();
+				reserve(capacity);
+			}
+			else if (size != stride_)
+			{
+				throw std::invalid_argument("All individuals of a contiguous population must have the same size");
+			}
+		}
+
+		/**
+		 * \brief Appends a row with given elements and fitness.
+		 * \param elements
+		 * \param size
+		 * \param fitness
+		 */
+		void append(const TElement * elements, const size_t size, const TFitness & fitness)
+		{
+			check_size(size);
+			grow();
+			std::copy(elements, elements + size, elements_.data() + size_ * stride_);
+			fitness_[size_] = fitness;
+			++size_;
+		}
+
+	public:
+		using value_type = ContiguousIndividual<TElement, TFitness>;
+		using iterator = typename std::vector<value_type>::iterator;
+		using const_iterator = typename std::vector<value_type>::const_iterator;
+
+		ContiguousPopulation() = default;
+
+		ContiguousPopulation(const ContiguousPopulation & other) : stride_(other.stride_)
+		{
+			reserve(other.size_);
+
+			for (auto && individual : other)
+			{
+				push_back(individual);
+			}
+		}
+
+		ContiguousPopulation(ContiguousPopulation && other) noexcept
+			: elements_(std::move(other.elements_)), fitness_(std::move(other.fitness_)), views_(std::move(other.views_)), stride_(other.stride_), size_(other.size_)
+		{
+			other.size_ = 0;
+		}
+
+		/**
+		 * \brief Copies rows of another population into the storage of this population.
+		 * \param other
+		 * \return
+		 */
+		ContiguousPopulation & operator=(const ContiguousPopulation & other)
+		{
+			if (this != &other)
+			{
+				clear();
+
+				for (auto && individual : other)
+				{
+					push_back(individual);
+				}
+			}
+
+			return *this;
+		}
+
+		ContiguousPopulation & operator=(ContiguousPopulation && other) noexcept
+		{
+			elements_ = std::move(other.elements_);
+			fitness_ = std::move(other.fitness_);
+			views_ = std::move(other.views_);
+			stride_ = other.stride_;
+			size_ = other.size_;
+			other.size_ = 0;
+
+			return *this;
+		}
+
+		/**
+		 * \brief Adds a copy of a given individual.
+		 * \param individual
+		 */
+		void push_back(const value_type & individual)
+		{
+			// A row of this population would move when the buffer grows
+			if (size_ == views_.size() && individual.is_view() && individual.begin() >= elements_.data() && individual.begin() < elements_.data() + elements_.size())
+			{
+				const value_type copy(individual);
+				append(copy.begin(), copy.size(), copy.fitness);
+
+				return;
+			}
+
+			append(individual.begin(), individual.size(), individual.fitness);
+		}
+
+		/**
+		 * \brief Constructs an individual from a given container and adds it. The container is copied into the buffer.
+		 * \param container
+		 */
+		void emplace_back(typename value_type::container_type && container)
+		{
+			append(container.data(), container.size(), TFitness{});
+		}
+
+		/**
+		 * \brief Removes all individuals. The storage is kept for the individuals that will be added later.
+		 */
+		void clear()
+		{
+			size_ = 0;
+		}
+
+		/**
+		 * \brief Reserves rows for a given number of individuals.
+		 * \param capacity
+		 */
+		void reserve(const size_t capacity)
+		{
+			if (capacity <= views_.size() && !views_.empty())
+			{
+				return;
+			}
+
+			elements_.resize(capacity * stride_);
+			fitness_.resize(capacity);
+
+			// Views point to the buffers, so they are created again after the buffers have moved
+			views_.clear();
+			views_.reserve(capacity);
+
+			for (size_t i = 0; i < capacity; ++i)
+			{
+				views_.emplace_back(elements_.data() + i * stride_, stride_, fitness_[i]);
+			}
+		}
+
+		size_t size() const
+		{
+			return size_;
+		}
+
+		bool empty() const
+		{
+			return size_ == 0;
+		}
+
+		/**
+		 * \brief Number of elements in each individual. All rows of the buffer are this far apart.
+		 * \return
+		 */
+		size_t stride() const
+		{
+			return stride_;
+		}
+
+		/**
+		 * \brief Row-major buffer with elements of all individuals.
+		 * \return
+		 */
+		const TElement * elements() const
+		{
+			return elements_.data();
+		}
+
+		/**
+		 * \brief Packed fitness values of all individuals.
+		 * \return
+		 */
+		const TFitness * fitness_values() const
+		{
+			return fitness_.data();
+		}
+
+		value_type & operator[](const size_t index)
+		{
+			return views_[index];
+		}
+
+		const value_type & operator[](const size_t index) const
+		{
+			return views_[index];
+		}
+
+		iterator begin()
+		{
+			return views_.begin();
+		}
+
+		iterator end()
+		{
+			return views_.begin() + size_;
+		}
+
+		const_iterator begin() const
+		{
+			return views_.begin();
+		}
+
+		const_iterator end() const
+		{
+			return views_.begin() + size_;
+		}
+
+		void swap(ContiguousPopulation & other) noexcept
+		{
+			elements_.swap(other.elements_);
+			fitness_.swap(other.fitness_);
+			views_.swap(other.views_);
+			std::swap(stride_, other.stride_);
+			std::swap(size_, other.size_);
+		}
+	};
+
+	template<typename TElement, typename TFitness>
+	void swap(ContiguousPopulation<TElement, TFitness> & first, ContiguousPopulation<TElement, TFitness> & second) noexcept
+	{
+		first.swap(second);
+	}
+}
+#endif // CONTIGUOUSPOPULATION_H
@@ -0,0 +1,185 @@
+#ifndef RECYCLINGPOPULATION_H
+#define RECYCLINGPOPULATION_H
+#include <utility>
+#include <vector>
+
+namespace ea
+{
+	/**
+	 * \brief Population container that keeps individuals alive when it is cleared.
+	 *		  New individuals are assigned into the kept ones, so their containers reuse already allocated storage.
+	 * \tparam TIndividual Type of individuals
+	 * \remarks Once the population reaches its final size, adding individuals does not allocate as long as
+	 *		    assigning an individual does not allocate (e.g. std::vector genomes of the same length).
+	 */
+	template<typename TIndividual>
+	class RecyclingPopulation
+	{
+		std::vector<TIndividual> individuals_;
+		size_t size_ = 0;
+
+	public:
+		using value_type = TIndividual;
+		using iterator = typename std::vector<TIndividual>::iterator;
+		using const_iterator = typename std::vector<TIndividual>::const_iterator;
+
+		RecyclingPopulation() = default;
+
+		RecyclingPopulation(const RecyclingPopulation & other)
+			: individuals_(other.begin(), other.end()), size_(other.size_)
+		{
+			/* empty */
+		}
+
+		RecyclingPopulation(RecyclingPopulation && other) noexcept
+			: individuals_(std::move(other.individuals_)), size_(other.size_)
+		{
+			other.size_ = 0;
+		}
+
+		/**
+		 * \brief Copies individuals of another population into the individuals of this population.
+		 * \param other
+		 * \return
+		 */
+		RecyclingPopulation & operator=(const RecyclingPopulation & other)
+		{
+			if (this != &other)
+			{
+				clear();
+
+				for (auto && individual : other)
+				{
+					push_back(individual);
+				}
+			}
+
+			return *this;
+		}
+
+		RecyclingPopulation & operator=(RecyclingPopulation && other) noexcept
+		{
+			individuals_ = std::move(other.individuals_);
+			size_ = other.size_;
+			other.size_ = 0;
+
+			return *this;
+		}
+
+		/**
+		 * \brief Adds a copy of a given individual. Reuses a kept individual if there is one.
+		 * \param individual
+		 */
+		void push_back(const TIndividual & individual)
+		{
+			if (size_ < individuals_.size())
+			{
+				individuals_[size_] = individual;
+			}
+			else
+			{
+				individuals_.push_back(individual);
+			}
+
+			++size_;
+		}
+
+		/**
+		 * \brief Adds a given individual. Reuses a kept individual if there is one.
+		 * \param individual
+		 */
+		void push_back(TIndividual && individual)
+		{
+			if (size_ < individuals_.size())
+			{
+				individuals_[size_] = std::move(individual);
+			}
+			else
+			{
+				individuals_.push_back(std::move(individual));
+			}
+
+			++size_;
+		}
+
+		/**
+		 * \brief Constructs an individual from given arguments and adds it.
+		 * \param args
+		 */
+		template<typename... TArgs>
+		void emplace_back(TArgs&&... args)
+		{
+			push_back(TIndividual(std::forward<TArgs>(args)...));
+		}
+
+		/**
+		 * \brief Removes all individuals. Their storage is kept for the individuals that will be added later.
+		 */
+		void clear()
+		{
+			size_ = 0;
+		}
+
+		/**
+		 * \brief Reserves space for a given number of individuals.
+		 * \param capacity
+		 */
+		void reserve(const size_t capacity)
+		{
+			individuals_.reserve(capacity);
+		}
+
+		size_t size() const
+		{
+			return size_;
+		}
+
+		bool empty() const
+		{
+			return size_ == 0;
+		}
+
+		TIndividual & operator[](const size_t index)
+		{
+			return individuals_[index];
+		}
+
+		const TIndividual & operator[](const size_t index) const
+		{
+			return individuals_[index];
+		}
+
+		iterator begin()
+		{
+			return individuals_.begin();
+		}
+
+		iterator end()
+		{
+			return individuals_.begin() + size_;
+		}
+
+		const_iterator begin() const
+		{
+			return individuals_.begin();
+		}
+
+		const_iterator end() const
+		{
+			return individuals_.begin() + size_;
+		}
+
+		void swap(RecyclingPopulation & other) noexcept
+		{
+			individuals_.swap(other.individuals_);
+			std::swap(size_, other.size_);
+		}
+	};
+
+	template<typename TIndividual>
+	void swap(RecyclingPopulation<TIndividual> & first, RecyclingPopulation<TIndividual> & second) noexcept
+	{
+		first.swap(second);
+	}
+}
+#endif // RECYCLINGPOPULATION_H
@@ -0,0 +1,81 @@
+#ifndef ONEMAXFITNESS_H
+#define ONEMAXFITNESS_H
+#include "Individuals/PackedBitIndividual.h"
+#include "Utils/Utils.h"
+
+namespace sga
+{
+	/**
+	 * \brief Fitness function for the OneMax problem. The value is the number of elements that are set to one.
+	 * \tparam TPopulation 
+	 */
+	template<typename TPopulation>
+	class OneMaxFitness
+	{
+		using individual_type = typename TPopulation::value_type;
+
+		/**
+		 * \brief Counts elements that are set one by one.
+		 * \tparam TIndividual 
+		 * \param individual 
+		 * \return 
+		 */
+		template<typename TIndividual>
+		static int count_ones(TIndividual & individual)
+		{
+			auto sum = 0;
+
+			for (auto && element : individual)
+			{
+				if (element)
+				{
+					++sum;
+				}
+			}
+
+			return sum;
+		}
+
+		/**
+		 * \brief Counts bits that are set word by word.
+		 * \tparam TFitness 
+		 * \param individual 
+		 * \return 
+		 */
+		template<typename TFitness>
+		static int count_ones(ea::PackedBitIndividual<TFitness> & individual)
+		{
+			auto sum = 0;
+
+			for (size_t i = 0; i < individual.word_count(); ++i)
+			{
+				sum += ea::popcount(individual.word(i));
+			}
+
+			return sum;
+		}
+
+	public:
+		/**
+		 * \brief Sets the fitness of all individuals.
+		 * \param population 
+		 */
+		void operator()(TPopulation & population) const
+		{
+			for (auto && individual : population)
+			{
+				operator()(individual);
+			}
+		}
+
+		/**
+		 * \brief Sets the fitness of a given individual.
+		 * \param individual 
+		 */
+		void operator()(individual_type & individual) const
+		{
+			individual.fitness = count_ones(individual);
+		}
+	};
+}
+#endif // ONEMAXFITNESS_H
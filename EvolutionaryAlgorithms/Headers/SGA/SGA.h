@@ -2,11 +2,13 @@
 #define SGA_H
 #include <vector>
 #include <array>
+#include <chrono>
 #include "EvolutionaryAlgorithm.h"
 #include "Operators/BitFlipMutation.h"
 #include "Operators/OnePtXOver.h"
 #include "Selectors/RouletteWheelSelector.h"
-#include "Individuals/GenericIndividual.h"
+#include "Individuals/PackedBitIndividual.h"
+#include "SGA/OneMaxFitness.h"
 #include "Utils/Initializer.h"
 #include "Utils/Settings.h"
 
@@ -15,6 +17,7 @@ namespace sga
 	struct SGASettings : ea::Settings
 	{
 		double bit_mutation_probability = 0.2; // Probability of mutating a bit
+		ea::GeneSampling gene_sampling = ea::GeneSampling::per_gene; // How are mutated bits chosen
 		double crossover_probability = 0.1; // Probability of crossover
 	};
 
@@ -22,6 +25,7 @@ namespace sga
 	std::string print_individual(TIndividual & individual)
 	{
 		std::string s = "<";
+		s.reserve(individual.size() + 2);
 
 		for (size_t i = 0; i < individual.size(); ++i)
 		{
@@ -36,37 +40,38 @@ namespace sga
 	template<size_t Size>
 	void solve_sga(const SGASettings & settings)
 	{
-		using individual_type = ea::GenericIndividual<std::array<bool, Size>, int>;
+		using individual_type = ea::PackedBitIndividual<int>;
 		using population_type = std::vector<individual_type>;
 
 		ea::EvolutionaryAlgorithm<population_type> ea{};
 
-		ea.add_operator(ea::BitFlipMutation<population_type>{settings.bit_mutation_probability});
+		ea.add_operator(ea::BitFlipMutation<population_type>{settings.bit_mutation_probability, settings.gene_sampling});
 		ea.add_operator(ea::OnePtXOver<population_type>{settings.crossover_probability});
 		ea.add_mating_selector(ea::RouletteWheelSelector<population_type>{});
-		ea.set_fitness([](auto & pop) -> void {
-			for (auto && individual : pop)
-			{
-				auto sum = 0;
+		ea.set_individual_fitness(OneMaxFitness<population_type>{});
+		ea.set_fitness_threads(settings.fitness_threads);
+		ea.set_batch_threads(settings.batch_threads);
 
-				for (auto && element : individual)
-				{
-					if (element)
-					{
-						++sum;
-					}
-				}
-
-				individual.fitness = sum;
-			}
-		});
+		if (settings.seed != 0)
+		{
+			ea.set_seed(settings.seed);
+		}
 
 		ea.set_elitism(settings.elitism);
 		ea.set_output_frequency(settings.output_frequency);
 		ea.set_individual_to_string(print_individual<individual_type>);
 		ea.set_objective([&](auto & ind) { return Size - ind.fitness; });
+		ea.set_objective_bound(0);
+		ea.set_stagnation_limit(settings.stagnation_generations);
+		ea.set_max_evaluations(settings.max_evaluations);
+		ea.set_time_limit(std::chrono::milliseconds(settings.time_limit_ms));
+
+		if (!settings.checkpoint_path.empty())
+		{
+			ea.set_checkpointing(settings.checkpoint_path, settings.checkpoint_generations, std::chrono::seconds(settings.checkpoint_interval_s));
+		}
 
-		ea.evolve_batch(settings.generations, settings.number_of_runs, [&]() { return ea::init_pop_uniform_bool<population_type>(settings.pop_size, Size); });
+		ea.evolve_batch(settings.generations, settings.number_of_runs, [&]() { return ea::init_pop_uniform_bits<population_type>(settings.pop_size, Size); });
 	}
 }
 #endif // SGA_H
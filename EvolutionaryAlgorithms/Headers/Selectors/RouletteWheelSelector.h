@@ -1,13 +1,28 @@
 #ifndef ROULETTEWHEELSELECTOR_H
 #define ROULETTEWHEELSELECTOR_H
+#include <algorithm>
 #include <random>
+#include <stdexcept>
+#include <vector>
+#include "Utils/Instrumentation.h"
+#include "Utils/Utils.h"
 
 namespace ea
 {
+	/**
+	 * \brief How the Roulette wheel selection draws individuals.
+	 */
+	enum class RouletteSampling
+	{
+		binary_search, // Binary search in prefix sums of fitness values, O(log N) per draw
+		alias // Walker's alias table built with the Vose's method, O(1) per draw
+	};
+
 	/**
 	 * \brief Class implementing the Roulette wheel selection
 	 * \tparam TPopulation Type of the population
 	 * \remarks https://en.wikipedia.org/wiki/Fitness_proportionate_selection
+	 *		    Tables are built once per call in O(N) and their storage is reused by later calls.
 	 */
 	template<typename TPopulation>
 	class RouletteWheelSelector
@@ -16,47 +31,159 @@ namespace ea
 		using fitness_type = typename individual_type::fitness_type;
 
 		std::uniform_real_distribution<> real_distribution_;
+		RouletteSampling sampling_;
+
+		std::vector<double> prefix_sums_;
+
+		std::vector<double> alias_probabilities_;
+		std::vector<size_t> aliases_;
+		std::vector<size_t> small_;
+		std::vector<size_t> large_;
+
+		/**
+		 * \brief Computes prefix sums of fitness values.
+		 * \param from
+		 * \return Sum of all fitness values
+		 */
+		double build_prefix_sums(const TPopulation & from)
+		{
+			prefix_sums_.resize(from.size());
+			double fitness_sum = 0;
+
+			for (size_t i = 0; i < from.size(); ++i)
+			{
+				if (from[i].fitness < 0)
+				{
+					throw std::logic_error{"Fitness of all individuals must be non-negative."};
+				}
+
+				fitness_sum += from[i].fitness;
+				prefix_sums_[i] = fitness_sum;
+			}
+
+			return fitness_sum;
+		}
+
+		/**
+		 * \brief Builds the alias table with the Vose's method.
+		 * \param from
+		 * \param fitness_sum
+		 */
+		void build_alias_table(const TPopulation & from, const double fitness_sum)
+		{
+			const auto size = from.size();
+			alias_probabilities_.resize(size);
+			aliases_.resize(size);
+			small_.clear();
+			large_.clear();
+
+			for (size_t i = 0; i < size; ++i)
+			{
+				alias_probabilities_[i] = from[i].fitness * static_cast<double>(size) / fitness_sum;
+				aliases_[i] = i;
+
+				if (alias_probabilities_[i] < 1)
+				{
+					small_.push_back(i);
+				}
+				else
+				{
+					large_.push_back(i);
+				}
+			}
+
+			while (!small_.empty() && !large_.empty())
+			{
+				const auto less = small_.back();
+				const auto more = large_.back();
+				small_.pop_back();
+
+				aliases_[less] = more;
+				alias_probabilities_[more] -= 1 - alias_probabilities_[less];
+
+				if (alias_probabilities_[more] < 1)
+				{
+					large_.pop_back();
+					small_.push_back(more);
+				}
+			}
+
+			// Entries left in either list are 1 up to rounding errors
+			for (auto && index : small_)
+			{
+				alias_probabilities_[index] = 1;
+			}
+
+			for (auto && index : large_)
+			{
+				alias_probabilities_[index] = 1;
+			}
+		}
 
 	public:
+		/**
+		 * \brief
+		 * \param sampling How are individuals drawn
+		 */
+		explicit RouletteWheelSelector(const RouletteSampling sampling = RouletteSampling::binary_search) : sampling_(sampling)
+		{
+			real_distribution_ = std::uniform_real_distribution<>(0, 1);
+		}
 
 		/**
 		 * \brief Uses the Roulette wheel selection to select a given number of individuals
 		 * \param from The source of individuals to be selected.
 		 * \param to The destination of selected individuals.
 		 * \param count How many individuals should be selected.
-		 * \remarks Fitness of all individuals must be non-negative.
+		 * \remarks Fitness of all individuals must be non-negative. If all of them are zero, individuals are selected uniformly.
 		 */
 		void operator()(const TPopulation & from, TPopulation & to, const size_t count)
 		{
-			fitness_type fitness_sum = 0;
+			if (from.size() == 0)
+			{
+				return;
+			}
+
+			// Genomes of a population have the same size
+			EA_COUNT(selector_draws, count);
+			EA_COUNT(bytes_copied, count * genome_bytes(from[0]));
+
+			const auto fitness_sum = build_prefix_sums(from);
 
-			for (auto&& individual : from)
+			if (fitness_sum <= 0)
 			{
-				if (individual.fitness < 0)
+				std::uniform_int_distribution<size_t> int_distribution(0, from.size() - 1);
+
+				for (size_t i = 0; i < count; ++i)
 				{
-					throw std::logic_error{"Fitness of all individuals must be non-negative."};
+					to.push_back(from[int_distribution(rng_gen())]);
 				}
 
-				fitness_sum += individual.fitness;
+				return;
 			}
 
-			auto counter = 0;
-			while (counter < count)
+			if (sampling_ == RouletteSampling::alias)
 			{
-				auto random = real_distribution_(rng_gen()) * fitness_sum;
-				fitness_type sum = 0;
+				build_alias_table(from, fitness_sum);
+				std::uniform_int_distribution<size_t> int_distribution(0, from.size() - 1);
 
-				for (auto&& individual : from)
+				for (size_t i = 0; i < count; ++i)
 				{
-					sum += individual.fitness;
-
-					if (random <= sum)
-					{
-						to.push_back(individual);
-						++counter;
-						break;
-					}
+					const auto index = int_distribution(rng_gen());
+					const auto selected = real_distribution_(rng_gen()) < alias_probabilities_[index] ? index : aliases_[index];
+					to.push_back(from[selected]);
 				}
+
+				return;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const auto random = real_distribution_(rng_gen()) * fitness_sum;
+				const auto selected = std::upper_bound(prefix_sums_.begin(), prefix_sums_.end(), random) - prefix_sums_.begin();
+
+				// Rounding errors can put the random number beyond the last prefix sum
+				to.push_back(from[(std::min)(static_cast<size_t>(selected), from.size() - 1)]);
 			}
 		}
 	};
@@ -0,0 +1,102 @@
+#ifndef STOCHASTICUNIVERSALSAMPLER_H
+#define STOCHASTICUNIVERSALSAMPLER_H
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "Utils/Instrumentation.h"
+#include "Utils/Utils.h"
+
+namespace ea
+{
+	/**
+	 * \brief Class implementing the Stochastic universal sampling
+	 * \tparam TPopulation Type of the population
+	 * \remarks https://en.wikipedia.org/wiki/Stochastic_universal_sampling
+	 *		    All individuals are selected in a single pass with evenly spaced pointers,
+	 *		    so the number of copies of each individual differs from its expected number by less than one.
+	 */
+	template<typename TPopulation>
+	class StochasticUniversalSampler
+	{
+		std::uniform_real_distribution<> real_distribution_;
+		std::vector<size_t> selected_;
+
+	public:
+		StochasticUniversalSampler()
+		{
+			real_distribution_ = std::uniform_real_distribution<>(0, 1);
+		}
+
+		/**
+		 * \brief Uses the Stochastic universal sampling to select a given number of individuals
+		 * \param from The source of individuals to be selected.
+		 * \param to The destination of selected individuals.
+		 * \param count How many individuals should be selected.
+		 * \remarks Fitness of all individuals must be non-negative. If all of them are zero, individuals are selected uniformly.
+		 *		    Selected individuals are shuffled so that consecutive pairs for crossovers are not copies of the same individual.
+		 */
+		void operator()(const TPopulation & from, TPopulation & to, const size_t count)
+		{
+			if (from.size() == 0 || count == 0)
+			{
+				return;
+			}
+
+			// Genomes of a population have the same size
+			EA_COUNT(selector_draws, count);
+			EA_COUNT(bytes_copied, count * genome_bytes(from[0]));
+
+			double fitness_sum = 0;
+
+			for (auto && individual : from)
+			{
+				if (individual.fitness < 0)
+				{
+					throw std::logic_error{"Fitness of all individuals must be non-negative."};
+				}
+
+				fitness_sum += individual.fitness;
+			}
+
+			selected_.clear();
+
+			if (fitness_sum <= 0)
+			{
+				std::uniform_int_distribution<size_t> int_distribution(0, from.size() - 1);
+
+				for (size_t i = 0; i < count; ++i)
+				{
+					selected_.push_back(int_distribution(rng_gen()));
+				}
+			}
+			else
+			{
+				const auto distance = fitness_sum / count;
+				auto pointer = real_distribution_(rng_gen()) * distance;
+				double sum = 0;
+				size_t index = 0;
+
+				for (size_t i = 0; i < count; ++i, pointer += distance)
+				{
+					// Skip individuals until the pointer is inside one of them, rounding errors must not move us beyond the last one
+					while (index < from.size() - 1 && sum + from[index].fitness <= pointer)
+					{
+						sum += from[index].fitness;
+						++index;
+					}
+
+					selected_.push_back(index);
+				}
+			}
+
+			std::shuffle(selected_.begin(), selected_.end(), rng_gen());
+
+			for (auto && index : selected_)
+			{
+				to.push_back(from[index]);
+			}
+		}
+	};
+}
+#endif // STOCHASTICUNIVERSALSAMPLER_H
@@ -1,6 +1,11 @@
 ﻿#ifndef TOURNAMENTSELECTOR_H
 #define TOURNAMENTSELECTOR_H
+#include <algorithm>
 #include <random>
+#include <stdexcept>
+#include <vector>
+#include "Utils/Instrumentation.h"
+#include "Utils/Utils.h"
 
 namespace ea
 {
@@ -8,6 +13,8 @@ namespace ea
 	* \brief Class implementing the Tournament selection
 	* \tparam TPopulation Type of the population
 	* \remarks https://en.wikipedia.org/wiki/Tournament_selection
+	*		   Contestants are drawn as indices in batches and compared by fitness values copied to a packed array,
+	*		   so only the winner of each tournament is copied.
 	*/
 	template<typename TPopulation>
 	class TournamentSelector
@@ -15,9 +22,53 @@ namespace ea
 		using t_individual = typename TPopulation::value_type;
 		using t_fitness = typename t_individual::fitness_type;
 
-		std::uniform_real_distribution<> real_distribution_;
+		size_t tournament_size_;
+		double pressure_;
+		std::geometric_distribution<size_t> rank_distribution_;
+
+		std::vector<t_fitness> fitness_;
+		std::vector<size_t> contestants_;
+
+		/**
+		 * \brief Picks the winner of a tournament. The i-th best contestant wins with the probability p*(1-p)^i and the worst one gets the rest.
+		 * \param contestants Indices of contestants. Their order is changed.
+		 * \return Index of the winner
+		 */
+		size_t play(size_t * contestants)
+		{
+			const auto rank = pressure_ == 1 ? 0 : (std::min)(rank_distribution_(rng_gen()), tournament_size_ - 1);
+			const auto better = [&](const size_t first, const size_t second) { return fitness_[first] > fitness_[second]; };
+
+			if (rank == 0)
+			{
+				return *std::min_element(contestants, contestants + tournament_size_, better);
+			}
+
+			std::nth_element(contestants, contestants + rank, contestants + tournament_size_, better);
+
+			return contestants[rank];
+		}
 
 	public:
+		/**
+		 * \brief
+		 * \param tournament_size Number of contestants in each tournament
+		 * \param pressure Probability that the best contestant wins. Lower values give weaker contestants a chance.
+		 */
+		explicit TournamentSelector(const size_t tournament_size = 2, const double pressure = 0.8) : tournament_size_(tournament_size), pressure_(pressure)
+		{
+			if (tournament_size == 0)
+				throw std::invalid_argument("tournament_size must be positive");
+
+			if (pressure <= 0 || pressure > 1)
+				throw std::invalid_argument("pressure must be from the interval (0,1]");
+
+			if (pressure < 1)
+			{
+				rank_distribution_ = std::geometric_distribution<size_t>(pressure);
+			}
+		}
+
 		/**
 		* \brief Uses the Tournament selection to select a given number of individuals
 		* \param from The source of individuals to be selected.
@@ -26,20 +77,39 @@ namespace ea
 		*/
 		void operator()(const TPopulation& from, TPopulation& to, const size_t count)
 		{
-			const std::uniform_int_distribution<int> int_distribution(0, from.size() - 1);
+			if (from.size() == 0)
+			{
+				return;
+			}
+
+			// Genomes of a population have the same size
+			EA_COUNT(selector_draws, count);
+			EA_COUNT(bytes_copied, count * genome_bytes(from[0]));
 
-			for (auto i = 0; i < count; ++i)
+			const size_t batch_size = 256;
+			std::uniform_int_distribution<size_t> int_distribution(0, from.size() - 1);
+
+			fitness_.resize(from.size());
+
+			for (size_t i = 0; i < from.size(); ++i)
 			{
-				auto i1 = from[int_distribution(ea::rng_gen())];
-				auto i2 = from[int_distribution(ea::rng_gen())];
+				fitness_[i] = from[i].fitness;
+			}
+
+			contestants_.resize(batch_size * tournament_size_);
 
-				if (i1.fitness > i2.fitness && real_distribution_(ea::rng_gen()) < 0.8)
+			for (size_t selected = 0; selected < count; selected += batch_size)
+			{
+				const auto tournaments = (std::min)(batch_size, count - selected);
+
+				for (size_t i = 0; i < tournaments * tournament_size_; ++i)
 				{
-					to.push_back(i1);
+					contestants_[i] = int_distribution(rng_gen());
 				}
-				else
+
+				for (size_t i = 0; i < tournaments; ++i)
 				{
-					to.push_back(i2);
+					to.push_back(from[play(&contestants_[i * tournament_size_])]);
 				}
 			}
 		}
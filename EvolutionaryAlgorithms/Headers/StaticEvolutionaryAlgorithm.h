@@ -0,0 +1,364 @@
+#ifndef STATICEVOLUTIONARYALGORITHM_H
+#define STATICEVOLUTIONARYALGORITHM_H
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Utils/Instrumentation.h"
+#include "Utils/Selection.h"
+#include "Utils/Utils.h"
+
+namespace ea
+{
+	/**
+	 * \brief List of stages (selectors or operators) of StaticEvolutionaryAlgorithm. Stages are applied in the order of the list.
+	 * \tparam TStages
+	 */
+	template<typename... TStages>
+	struct Stages
+	{
+		std::tuple<TStages...> stages;
+	};
+
+	/**
+	 * \brief Creates a list of stages.
+	 * \tparam TStages
+	 * \param stages
+	 * \return
+	 */
+	template<typename... TStages>
+	Stages<TStages...> make_stages(TStages... stages)
+	{
+		return Stages<TStages...>{ std::tuple<TStages...>(std::move(stages)...) };
+	}
+
+	/**
+	 * \brief Whether an operator changes a pair of individuals with apply(first, second), like crossovers.
+	 */
+	template<typename TOperator, typename TIndividual, typename = void>
+	struct applies_to_pairs : std::false_type {};
+
+	template<typename TOperator, typename TIndividual>
+	struct applies_to_pairs<TOperator, TIndividual, decltype(void(std::declval<TOperator &>().apply(std::declval<TIndividual &>(), std::declval<TIndividual &>())))> : std::true_type {};
+
+	/**
+	 * \brief Whether an operator changes a single individual with apply(individual), like mutations.
+	 */
+	template<typename TOperator, typename TIndividual, typename = void>
+	struct applies_to_individuals : std::false_type {};
+
+	template<typename TOperator, typename TIndividual>
+	struct applies_to_individuals<TOperator, TIndividual, decltype(void(std::declval<TOperator &>().apply(std::declval<TIndividual &>())))> : std::true_type {};
+
+	/**
+	 * \brief Whether all given values are true.
+	 */
+	template<bool... Values>
+	struct all_true : std::is_same<std::integer_sequence<bool, true, Values...>, std::integer_sequence<bool, Values..., true>> {};
+
+	template<typename TPopulation, typename TFitness, typename TMatingSelectors, typename TOperators, typename TNaturalSelectors = Stages<>>
+	class StaticEvolutionaryAlgorithm;
+
+	/**
+	 * \brief Evolutionary algorithm whose selectors, operators and fitness function are fixed at compile time.
+	 *		  Stages are called directly instead of through std::function, so the compiler can inline them into the generation loop.
+	 *		  A generation works the same way as in EvolutionaryAlgorithm, except that if every operator changes pairs
+	 *		  or single individuals (apply), the operators and the fitness are fused into one pass over the offspring:
+	 *		  each pair is crossed, mutated and evaluated while it is in the cache. Other operators change the whole
+	 *		  population one after another.
+	 * \tparam TPopulation Type of the population
+	 * \tparam TFitness Fitness function that evaluates a single individual
+	 * \tparam TMatingSelectors Types of mating selectors
+	 * \tparam TOperators Types of operators
+	 * \tparam TNaturalSelectors Types of natural selectors
+	 * \remarks The fitness is evaluated on the calling thread. Progress is not printed, use EvolutionaryAlgorithm for that.
+	 */
+	template<typename TPopulation, typename TFitness, typename... TMatingSelectors, typename... TOperators, typename... TNaturalSelectors>
+	class StaticEvolutionaryAlgorithm<TPopulation, TFitness, Stages<TMatingSelectors...>, Stages<TOperators...>, Stages<TNaturalSelectors...>>
+	{
+		using individual_type = typename TPopulation::value_type;
+		using fitness_value_type = typename individual_type::fitness_type;
+
+		TFitness fitness_;
+		std::tuple<TMatingSelectors...> mating_selectors_;
+		std::tuple<TOperators...> operators_;
+		std::tuple<TNaturalSelectors...> natural_selectors_;
+
+		double elitism_percentage_ = 0;
+
+		// Buffers that are kept between generations
+		TPopulation offspring_{};
+		std::vector<std::pair<fitness_value_type, size_t>> elite_candidates_;
+
+		size_t best_index_ = 0;
+
+		// Whether the operators and the fitness are applied in one pass over the offspring
+		using fused = std::integral_constant<bool, all_true<(applies_to_pairs<TOperators, individual_type>::value || applies_to_individuals<TOperators, individual_type>::value)...>::value>;
+
+		/**
+		 * \brief Lets each selector of a tuple select its portion of a given number of individuals.
+		 */
+		template<typename TSelectors, size_t... Indices>
+		static void select(TSelectors & selectors, const TPopulation & from, TPopulation & to, const size_t count, std::index_sequence<Indices...>)
+		{
+			const int expand[] = { 0, (std::get<Indices>(selectors)(from, to, how_many_should_select(Indices, sizeof...(Indices), count)), 0)... };
+			(void)expand;
+			// Unused if there are no selectors
+			(void)count;
+		}
+
+		/**
+		 * \brief Applies all operators in the order of the list.
+		 */
+		template<size_t... Indices>
+		void apply_operators(TPopulation & population, std::index_sequence<Indices...>)
+		{
+			const int expand[] = { 0, (std::get<Indices>(operators_)(population), 0)... };
+			(void)expand;
+		}
+
+		/**
+		 * \brief Applies an operator that changes pairs to a pair of individuals.
+		 */
+		template<typename TOperator>
+		static void apply_to_pair(TOperator & op, individual_type & first, individual_type & second, std::true_type)
+		{
+			op.apply(first, second);
+		}
+
+		/**
+		 * \brief Applies an operator that changes single individuals to both individuals of a pair.
+		 */
+		template<typename TOperator>
+		static void apply_to_pair(TOperator & op, individual_type & first, individual_type & second, std::false_type)
+		{
+			op.apply(first);
+			op.apply(second);
+		}
+
+		/**
+		 * \brief An operator that changes pairs leaves the individual without a pair unchanged.
+		 */
+		template<typename TOperator>
+		static void apply_to_individual(TOperator &, individual_type &, std::true_type)
+		{
+		}
+
+		/**
+		 * \brief Applies an operator that changes single individuals to the individual without a pair.
+		 */
+		template<typename TOperator>
+		static void apply_to_individual(TOperator & op, individual_type & individual, std::false_type)
+		{
+			op.apply(individual);
+		}
+
+		/**
+		 * \brief Applies all operators to a pair of individuals in the order of the list.
+		 */
+		template<size_t... Indices>
+		void apply_operators(individual_type & first, individual_type & second, std::index_sequence<Indices...>)
+		{
+			const int expand[] = { 0, (apply_to_pair(std::get<Indices>(operators_), first, second, applies_to_pairs<TOperators, individual_type>{}), 0)... };
+			(void)expand;
+		}
+
+		/**
+		 * \brief Applies all operators that change single individuals to the individual without a pair.
+		 */
+		template<size_t... Indices>
+		void apply_operators(individual_type & individual, std::index_sequence<Indices...>)
+		{
+			const int expand[] = { 0, (apply_to_individual(std::get<Indices>(operators_), individual, applies_to_pairs<TOperators, individual_type>{}), 0)... };
+			(void)expand;
+		}
+
+		/**
+		 * \brief Changes and evaluates the offspring pair by pair.
+		 *		  Pairs are the consecutive individuals that crossovers take, the last individual of an odd population is only mutated.
+		 */
+		void create_offspring(std::true_type)
+		{
+			const auto pairs = offspring_.size() / 2;
+
+			for (size_t i = 0; i < pairs; ++i)
+			{
+				auto & first = offspring_[2 * i];
+				auto & second = offspring_[2 * i + 1];
+
+				apply_operators(first, second, std::index_sequence_for<TOperators...>{});
+				fitness_(first);
+				fitness_(second);
+			}
+
+			if (offspring_.size() % 2 != 0)
+			{
+				auto & last = offspring_[offspring_.size() - 1];
+
+				apply_operators(last, std::index_sequence_for<TOperators...>{});
+				fitness_(last);
+			}
+
+			EA_COUNT(evaluations, offspring_.size());
+		}
+
+		/**
+		 * \brief Applies the operators to the whole offspring one after another and evaluates it.
+		 */
+		void create_offspring(std::false_type)
+		{
+			apply_operators(offspring_, std::index_sequence_for<TOperators...>{});
+			evaluate(offspring_);
+		}
+
+	public:
+		/**
+		 * \brief
+		 * \param fitness Fitness function that evaluates a single individual
+		 * \param mating_selectors
+		 * \param operators
+		 * \param natural_selectors If there are none, offspring are taken in the order in which they were created.
+		 */
+		StaticEvolutionaryAlgorithm(TFitness fitness, Stages<TMatingSelectors...> mating_selectors, Stages<TOperators...> operators, Stages<TNaturalSelectors...> natural_selectors = {})
+			: fitness_(std::move(fitness)), mating_selectors_(std::move(mating_selectors.stages)), operators_(std::move(operators.stages)), natural_selectors_(std::move(natural_selectors.stages))
+		{
+			static_assert(sizeof...(TMatingSelectors) > 0, "At least one mating selector is required");
+		}
+
+		/**
+		 * \brief Configures elitism.
+		 * \param percentage What percentage of the best individuals should be kept.
+		 */
+		void set_elitism(const double percentage)
+		{
+			if (percentage > 1 || percentage < 0)
+			{
+				throw std::invalid_argument("Percentage must be less than 1 and greater than 0");
+			}
+
+			elitism_percentage_ = percentage;
+		}
+
+		/**
+		 * \brief Updates the fitness of all individuals in the population.
+		 * \param population
+		 */
+		void evaluate(TPopulation & population)
+		{
+			EA_COUNT(evaluations, population.size());
+
+			for (auto && individual : population)
+			{
+				fitness_(individual);
+			}
+		}
+
+		/**
+		 * \brief Does one iteration of the evolutionary algorithm.
+		 * \param population
+		 * \return The next generation
+		 */
+		TPopulation evolve(const TPopulation & population)
+		{
+			TPopulation new_pop{};
+			evolve(population, new_pop);
+
+			return new_pop;
+		}
+
+		/**
+		 * \brief Does one iteration of the evolutionary algorithm and stores the next generation to a given population.
+		 * \param population The current generation
+		 * \param next_pop Population that is overwritten with the next generation. Must not be the same object as population.
+		 */
+		void evolve(const TPopulation & population, TPopulation & next_pop)
+		{
+			offspring_.clear();
+			select(mating_selectors_, population, offspring_, population.size(), std::index_sequence_for<TMatingSelectors...>{});
+			create_offspring(fused{});
+
+			auto select_count = population.size();
+			next_pop.clear();
+
+			if (elitism_percentage_ != 0)
+			{
+				const auto elite_count = static_cast<size_t>(std::ceil(population.size() * elitism_percentage_));
+				select_elites(population, elite_count, elite_candidates_);
+
+				for (size_t i = 0; i < elite_count; ++i)
+				{
+					next_pop.push_back(population[elite_candidates_[i].second]);
+				}
+
+				EA_COUNT(bytes_copied, elite_count == 0 ? 0 : elite_count * genome_bytes(population[0]));
+
+				select_count -= elite_count;
+			}
+
+			if (sizeof...(TNaturalSelectors) != 0)
+			{
+				select(natural_selectors_, offspring_, next_pop, select_count, std::index_sequence_for<TNaturalSelectors...>{});
+			}
+			else
+			{
+				for (size_t i = 0; i < select_count; ++i)
+				{
+					next_pop.push_back(offspring_[i]);
+				}
+
+				EA_COUNT(bytes_copied, select_count == 0 ? 0 : select_count * genome_bytes(offspring_[0]));
+			}
+
+			best_index_ = find_best_index(next_pop);
+		}
+
+		/**
+		 * \brief Evolve the population for a given number of generations
+		 * \remarks Every generation draws from its own stream of the random generator of the current thread (see rng_generation).
+		 * \param population The initial population
+		 * \param generations How many generations should we evolve
+		 * \return The best individual
+		 */
+		individual_type evolve(TPopulation population, const size_t generations)
+		{
+			TPopulation next_pop{};
+
+			for (size_t i = 0; i < generations; ++i)
+			{
+				rng_generation(i + 1);
+				evolve(population, next_pop);
+				std::swap(population, next_pop);
+			}
+
+			return population[generations == 0 ? find_best_index(population) : best_index_];
+		}
+
+		/**
+		 * \brief Index of the best individual in the population that was created by the last call of evolve.
+		 * \return
+		 */
+		size_t best_index() const
+		{
+			return best_index_;
+		}
+	};
+
+	/**
+	 * \brief Creates a StaticEvolutionaryAlgorithm and deduces the types of its stages.
+	 * \tparam TPopulation Type of the population
+	 * \param fitness Fitness function that evaluates a single individual
+	 * \param mating_selectors Created with make_stages
+	 * \param operators Created with make_stages
+	 * \param natural_selectors Created with make_stages
+	 * \return
+	 */
+	template<typename TPopulation, typename TFitness, typename TMatingSelectors, typename TOperators, typename TNaturalSelectors = Stages<>>
+	StaticEvolutionaryAlgorithm<TPopulation, TFitness, TMatingSelectors, TOperators, TNaturalSelectors>
+		make_static_algorithm(TFitness fitness, TMatingSelectors mating_selectors, TOperators operators, TNaturalSelectors natural_selectors = {})
+	{
+		return { std::move(fitness), std::move(mating_selectors), std::move(operators), std::move(natural_selectors) };
+	}
+}
+#endif // STATICEVOLUTIONARYALGORITHM_H
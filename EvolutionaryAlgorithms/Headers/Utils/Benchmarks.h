@@ -1,49 +1,231 @@
 ﻿#ifndef BENCHMARKS_H
 #define BENCHMARKS_H
+#include "Utils/StageTimes.h"
 #include "Utils/TimeMeasuring.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <string>
+#include <vector>
 
 namespace ea
 {
 	/**
 	 * \brief Runs a benchmark of the algorithm.
-	 * \tparam TEvolutionaryAlgorithm 
-	 * \tparam TPopulation 
-	 * \param ea 
-	 * \param population 
-	 * \param generation_count 
-	 * \return 
+	 * \tparam TEvolutionaryAlgorithm
+	 * \tparam TPopulation
+	 * \param ea
+	 * \param population The initial population
+	 * \param generation_count
+	 * \return Total time in milliseconds
 	 */
 	template<typename TEvolutionaryAlgorithm, typename TPopulation>
-	unsigned long long benchmark(TEvolutionaryAlgorithm ea, TPopulation population, const int generation_count)
+	unsigned long long benchmark(TEvolutionaryAlgorithm & ea, TPopulation population, const int generation_count)
 	{
-		const auto time_start = GetTimeMs64();
+		TPopulation next_pop{};
+		const auto time_start = std::chrono::steady_clock::now();
 
 		for (auto i = 0; i < generation_count; ++i)
 		{
-			population = ea.evolve(population);
+			ea.evolve(population, next_pop);
+			std::swap(population, next_pop);
 		}
 
-		const auto time_end = GetTimeMs64();
-		const auto time_total_ms = time_end - time_start;
+		const auto time_end = std::chrono::steady_clock::now();
 
-		return time_total_ms;
+		return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::milliseconds>(time_end - time_start).count());
 	}
 
 	/**
 	 * \brief Runs the benchamrk of the algorithm and outputs the results.
-	 * \tparam TEvolutionaryAlgorithm 
-	 * \tparam TPopulation 
-	 * \param ea 
-	 * \param population 
-	 * \param generation_count 
+	 * \tparam TEvolutionaryAlgorithm
+	 * \tparam TPopulation
+	 * \param ea
+	 * \param population
+	 * \param generation_count
 	 */
 	template<typename TEvolutionaryAlgorithm, typename TPopulation>
-	void benchmark_and_output(TEvolutionaryAlgorithm ea, TPopulation population, const int generation_count)
+	void benchmark_and_output(TEvolutionaryAlgorithm & ea, const TPopulation & population, const int generation_count)
 	{
 		auto time_total_ms = benchmark(ea, population, generation_count);
 
 		std::cout << "Generations: " << generation_count << ", total ms: " << time_total_ms << ", ms per generation: " << (time_total_ms / static_cast<double>(generation_count)) << std::endl;
 	}
+
+	/**
+	 * \brief Measures how long it takes to evaluate the fitness of the whole population.
+	 * \tparam TEvolutionaryAlgorithm
+	 * \tparam TPopulation
+	 * \param ea Configured algorithm. Its fitness threads setting is used.
+	 * \param population Population to evaluate. Fitness values are updated.
+	 * \param repetitions How many times should the population be evaluated
+	 * \return Total time in milliseconds
+	 */
+	template<typename TEvolutionaryAlgorithm, typename TPopulation>
+	unsigned long long benchmark_fitness(TEvolutionaryAlgorithm & ea, TPopulation & population, const int repetitions)
+	{
+		const auto time_start = std::chrono::steady_clock::now();
+
+		for (auto i = 0; i < repetitions; ++i)
+		{
+			ea.evaluate(population);
+		}
+
+		const auto time_end = std::chrono::steady_clock::now();
+
+		return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::milliseconds>(time_end - time_start).count());
+	}
+
+	/**
+	 * \brief Summary of a set of samples.
+	 */
+	struct SampleStatistics
+	{
+		size_t count = 0;
+		double mean = 0;
+		double median = 0;
+		double p95 = 0; // 95th percentile
+		double variance = 0; // Sample variance
+	};
+
+	/**
+	 * \brief Computes statistics of given samples. Percentiles are linearly interpolated between the closest ranks.
+	 * \param samples
+	 * \return
+	 */
+	inline SampleStatistics compute_statistics(std::vector<double> samples)
+	{
+		SampleStatistics statistics;
+		statistics.count = samples.size();
+
+		if (samples.empty())
+		{
+			return statistics;
+		}
+
+		std::sort(samples.begin(), samples.end());
+
+		const auto percentile = [&](const double fraction) {
+			const auto position = fraction * (samples.size() - 1);
+			const auto lower = static_cast<size_t>(std::floor(position));
+			const auto upper = (std::min)(lower + 1, samples.size() - 1);
+
+			return samples[lower] + (samples[upper] - samples[lower]) * (position - lower);
+		};
+
+		double sum = 0;
+
+		for (auto && sample : samples)
+		{
+			sum += sample;
+		}
+
+		statistics.mean = sum / samples.size();
+		statistics.median = percentile(0.5);
+		statistics.p95 = percentile(0.95);
+
+		if (samples.size() > 1)
+		{
+			double squares = 0;
+
+			for (auto && sample : samples)
+			{
+				squares += (sample - statistics.mean) * (sample - statistics.mean);
+			}
+
+			statistics.variance = squares / (samples.size() - 1);
+		}
+
+		return statistics;
+	}
+
+	/**
+	 * \brief One row of a stage benchmark - statistics of a single stage in a single configuration.
+	 */
+	struct StageBenchmarkRow
+	{
+		std::string problem;
+		size_t pop_size;
+		size_t genome_length;
+		size_t threads;
+		Stage stage;
+		size_t index;
+		SampleStatistics nanoseconds;
+	};
+
+	/**
+	 * \brief Converts recorded stage times to rows of a benchmark report.
+	 * \param times
+	 * \param problem
+	 * \param pop_size
+	 * \param genome_length
+	 * \param threads
+	 * \param rows Rows are appended to this array
+	 */
+	inline void add_stage_rows(const StageTimes & times, const std::string & problem, const size_t pop_size, const size_t genome_length, const size_t threads, std::vector<StageBenchmarkRow> & rows)
+	{
+		for (auto && entry : times.entries())
+		{
+			rows.push_back(StageBenchmarkRow{ problem, pop_size, genome_length, threads, entry.stage, entry.index, compute_statistics(entry.nanoseconds) });
+		}
+	}
+
+	/**
+	 * \brief Writes rows of a stage benchmark as CSV with a header line. Times are in nanoseconds.
+	 * \param rows
+	 * \param out
+	 */
+	inline void write_stage_csv(const std::vector<StageBenchmarkRow> & rows, std::ostream & out)
+	{
+		// Nanoseconds are printed as fixed point numbers so that large values keep all digits
+		const auto flags = out.flags();
+		const auto precision = out.precision();
+		out << std::fixed << std::setprecision(1);
+
+		out << "problem,pop_size,genome_length,threads,stage,index,samples,mean_ns,median_ns,p95_ns,variance_ns2" << std::endl;
+
+		for (auto && row : rows)
+		{
+			out << row.problem << ',' << row.pop_size << ',' << row.genome_length << ',' << row.threads << ','
+				<< stage_name(row.stage) << ',' << row.index << ',' << row.nanoseconds.count << ',' << row.nanoseconds.mean << ','
+				<< row.nanoseconds.median << ',' << row.nanoseconds.p95 << ',' << row.nanoseconds.variance << std::endl;
+		}
+
+		out.flags(flags);
+		out.precision(precision);
+	}
+
+	/**
+	 * \brief Writes rows of a stage benchmark as a JSON array of objects. Times are in nanoseconds.
+	 * \param rows
+	 * \param out
+	 */
+	inline void write_stage_json(const std::vector<StageBenchmarkRow> & rows, std::ostream & out)
+	{
+		// Nanoseconds are printed as fixed point numbers so that large values keep all digits
+		const auto flags = out.flags();
+		const auto precision = out.precision();
+		out << std::fixed << std::setprecision(1);
+
+		out << "[" << std::endl;
+
+		for (size_t i = 0; i < rows.size(); ++i)
+		{
+			auto & row = rows[i];
+
+			out << "  {\"problem\": \"" << row.problem << "\", \"pop_size\": " << row.pop_size << ", \"genome_length\": " << row.genome_length
+				<< ", \"threads\": " << row.threads << ", \"stage\": \"" << stage_name(row.stage) << "\", \"index\": " << row.index
+				<< ", \"samples\": " << row.nanoseconds.count << ", \"mean_ns\": " << row.nanoseconds.mean << ", \"median_ns\": " << row.nanoseconds.median
+				<< ", \"p95_ns\": " << row.nanoseconds.p95 << ", \"variance_ns2\": " << row.nanoseconds.variance << "}"
+				<< (i + 1 < rows.size() ? "," : "") << std::endl;
+		}
+
+		out << "]" << std::endl;
+
+		out.flags(flags);
+		out.precision(precision);
+	}
 }
 #endif // BENCHMARKS_H
@@ -0,0 +1,155 @@
+#ifndef BLOCKSWAP_H
+#define BLOCKSWAP_H
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "Utils/Utils.h"
+
+namespace ea
+{
+	/**
+	 * \brief Swaps two non-overlapping arrays of trivially copyable elements.
+	 *		  Bytes are swapped in 64-bit words which the compiler vectorizes, so small elements (e.g. bool) are not swapped one by one.
+	 * \tparam TElement
+	 * \param first
+	 * \param second
+	 * \param count Number of elements
+	 */
+	template<typename TElement>
+	void swap_blocks(TElement * first, TElement * second, const size_t count)
+	{
+		static_assert(std::is_trivially_copyable<TElement>::value, "Elements must be trivially copyable");
+
+		auto first_bytes = reinterpret_cast<unsigned char *>(first);
+		auto second_bytes = reinterpret_cast<unsigned char *>(second);
+		const auto bytes = count * sizeof(TElement);
+		size_t i = 0;
+
+		for (; i + sizeof(uint64_t) <= bytes; i += sizeof(uint64_t))
+		{
+			uint64_t first_word, second_word;
+			std::memcpy(&first_word, first_bytes + i, sizeof(uint64_t));
+			std::memcpy(&second_word, second_bytes + i, sizeof(uint64_t));
+			std::memcpy(first_bytes + i, &second_word, sizeof(uint64_t));
+			std::memcpy(second_bytes + i, &first_word, sizeof(uint64_t));
+		}
+
+		for (; i < bytes; ++i)
+		{
+			const auto temp = first_bytes[i];
+			first_bytes[i] = second_bytes[i];
+			second_bytes[i] = temp;
+		}
+	}
+
+	template<typename TElement>
+	void swap_arrays(TElement * first, TElement * second, const size_t count, std::true_type)
+	{
+		swap_blocks(first, second, count);
+	}
+
+	template<typename TElement>
+	void swap_arrays(TElement * first, TElement * second, const size_t count, std::false_type)
+	{
+		std::swap_ranges(first, first + count, second);
+	}
+
+	/**
+	 * \brief Swaps two non-overlapping arrays. Trivially copyable elements are swapped in words with swap_blocks.
+	 * \tparam TElement
+	 * \param first
+	 * \param second
+	 * \param count Number of elements
+	 */
+	template<typename TElement>
+	void swap_arrays(TElement * first, TElement * second, const size_t count)
+	{
+		swap_arrays(first, second, count, std::is_trivially_copyable<TElement>{});
+	}
+
+	/**
+	 * \brief Calls a given function for each position in [0, size) whose bit in a mask is set.
+	 * \tparam TFunction
+	 * \param size
+	 * \param mask Bit i of the word (i / 64) belongs to the position i.
+	 * \param function Function that is called with the position
+	 */
+	template<typename TFunction>
+	void for_each_set_bit(const size_t size, const uint64_t * mask, TFunction function)
+	{
+		for (size_t offset = 0; offset < size; offset += 64)
+		{
+			auto word = mask[offset / 64];
+
+			if (size - offset < 64)
+			{
+				word &= (uint64_t{ 1 } << (size - offset)) - 1;
+			}
+
+			while (word != 0)
+			{
+				function(offset + count_trailing_zeros(word));
+				word &= word - 1;
+			}
+		}
+	}
+
+	/**
+	 * \brief Swaps elements in the range [begin, end) of two containers with contiguous storage of trivially copyable elements.
+	 */
+	template<typename TContainer>
+	auto swap_container_ranges(TContainer & first, TContainer & second, const size_t begin, const size_t end, int)
+		-> typename std::enable_if<std::is_trivially_copyable<typename std::remove_pointer<decltype(first.data())>::type>::value>::type
+	{
+		if (begin < end)
+		{
+			swap_blocks(first.data() + begin, second.data() + begin, end - begin);
+		}
+	}
+
+	/**
+	 * \brief Swaps elements in the range [begin, end) of two containers element by element.
+	 */
+	template<typename TContainer>
+	void swap_container_ranges(TContainer & first, TContainer & second, const size_t begin, const size_t end, long)
+	{
+		if (begin < end)
+		{
+			std::swap_ranges(std::begin(first) + begin, std::begin(first) + end, std::begin(second) + begin);
+		}
+	}
+
+	/**
+	 * \brief Swaps elements in the range [begin, end) of two containers. Contiguous containers of trivially copyable elements are swapped in blocks.
+	 * \tparam TContainer
+	 * \param first
+	 * \param second
+	 * \param begin
+	 * \param end
+	 */
+	template<typename TContainer>
+	void swap_container_ranges(TContainer & first, TContainer & second, const size_t begin, const size_t end)
+	{
+		swap_container_ranges(first, second, begin, end, 0);
+	}
+
+	/**
+	 * \brief Swaps elements of two containers whose bits in a given mask are set.
+	 * \tparam TContainer
+	 * \param first
+	 * \param second
+	 * \param size Number of elements
+	 * \param mask Bit i of the word (i / 64) belongs to the element i.
+	 */
+	template<typename TContainer>
+	void swap_container_masked(TContainer & first, TContainer & second, const size_t size, const uint64_t * mask)
+	{
+		for_each_set_bit(size, mask, [&](const size_t index)
+		{
+			std::swap(first[index], second[index]);
+		});
+	}
+}
+#endif // BLOCKSWAP_H
@@ -0,0 +1,497 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Individuals/PackedBitIndividual.h"
+#include "Utils/MappedFile.h"
+#include "Utils/Random.h"
+#include "Utils/Termination.h"
+
+namespace ea
+{
+	/**
+	 * \brief Version of the checkpoint format that is written. Files of other versions are rejected.
+	 */
+	const uint32_t checkpoint_version = 1;
+
+	/**
+	 * \brief Written to every checkpoint to detect files from machines with a different byte order.
+	 */
+	const uint64_t checkpoint_byte_order = 0x0102030405060708;
+
+	/**
+	 * \brief Header at the beginning of a checkpoint file.
+	 * \remarks The file consists of the header, the best fitness of the run, the fitness of every individual
+	 *		    and the genome of every individual. Every section and every genome starts at a multiple of 8 bytes,
+	 *		    so a memory-mapped file can be read in place.
+	 */
+	struct CheckpointHeader
+	{
+		char magic[8]; // "EACKPT" followed by zeros
+		uint32_t version;
+		uint32_t header_bytes;
+		uint64_t byte_order;
+		uint64_t seed; // Master seed of the random streams
+		uint64_t run; // Coordinates of the random stream (StreamId)
+		uint64_t island;
+		uint32_t stream_generation;
+		uint32_t stream_individual;
+		uint64_t rng_position; // Words drawn from the random stream
+		uint64_t generation; // Number of completed generations
+		uint64_t evaluations;
+		uint64_t stagnant_generations;
+		int64_t elapsed_ns; // Time the run took so far
+		uint32_t finished; // Whether the run stopped because of its own stop conditions
+		uint32_t stop_reason;
+		uint64_t population_size;
+		uint64_t genome_length; // Number of elements of every genome
+		uint64_t element_bits; // Number of bits of a stored element
+		uint64_t genome_bytes; // Number of bytes of every stored genome, including the padding
+		uint64_t fitness_bytes;
+		uint64_t best_fitness_offset;
+		uint64_t fitness_offset;
+		uint64_t genomes_offset;
+		uint64_t file_bytes;
+		uint64_t checksum; // FNV-1a hash of everything after the header
+	};
+
+	static_assert(sizeof(CheckpointHeader) == 184, "The checkpoint header must not contain padding");
+
+	/**
+	 * \brief State of a run that is stored in a checkpoint together with its population.
+	 * \tparam TFitness
+	 */
+	template<typename TFitness>
+	struct CheckpointState
+	{
+		uint64_t seed = 0;
+		StreamId stream{};
+		uint64_t rng_position = 0;
+		size_t generation = 0;
+		size_t evaluations = 0;
+		size_t stagnant_generations = 0;
+		TFitness best_fitness{}; // Best fitness so far, meaningful only if generation is not 0
+		std::chrono::steady_clock::duration elapsed{ 0 };
+		bool finished = false;
+		StopReason reason = StopReason::generations;
+	};
+
+	/**
+	 * \brief Converts genomes of individuals to bytes and back. Elements are stored one by one in their native representation.
+	 * \remarks Specialize the template for individuals whose genome is not a sequence of trivially copyable elements
+	 *		    or that can be stored more compactly.
+	 * \tparam TIndividual
+	 */
+	template<typename TIndividual>
+	struct GenomeCodec
+	{
+		using element_type = typename TIndividual::element_type;
+
+		static_assert(std::is_trivially_copyable<element_type>::value, "Elements must be trivially copyable");
+
+		static const uint64_t element_bits = sizeof(element_type) * 8;
+
+		static size_t length(const TIndividual & individual)
+		{
+			return individual.size();
+		}
+
+		static size_t bytes(const size_t length)
+		{
+			return length * sizeof(element_type);
+		}
+
+		static void write(const TIndividual & individual, char * output)
+		{
+			for (size_t i = 0; i < individual.size(); ++i)
+			{
+				const element_type value = individual[i];
+				std::memcpy(output + i * sizeof(element_type), &value, sizeof(element_type));
+			}
+		}
+
+		static TIndividual read(const char * input, const size_t length)
+		{
+			typename TIndividual::container_type container(length);
+
+			for (size_t i = 0; i < length; ++i)
+			{
+				element_type value;
+				std::memcpy(&value, input + i * sizeof(element_type), sizeof(element_type));
+				container[i] = value;
+			}
+
+			return TIndividual(std::move(container));
+		}
+	};
+
+	/**
+	 * \brief Stores packed bits as whole words.
+	 * \tparam TFitness
+	 */
+	template<typename TFitness>
+	struct GenomeCodec<PackedBitIndividual<TFitness>>
+	{
+		using individual_type = PackedBitIndividual<TFitness>;
+
+		static const uint64_t element_bits = 1;
+
+		static size_t length(const individual_type & individual)
+		{
+			return individual.size();
+		}
+
+		static size_t bytes(const size_t length)
+		{
+			return (length + 63) / 64 * sizeof(uint64_t);
+		}
+
+		static void write(const individual_type & individual, char * output)
+		{
+			for (size_t i = 0; i < individual.word_count(); ++i)
+			{
+				const auto word = individual.word(i);
+				std::memcpy(output + i * sizeof(uint64_t), &word, sizeof(uint64_t));
+			}
+		}
+
+		static individual_type read(const char * input, const size_t length)
+		{
+			individual_type individual(length);
+
+			for (size_t i = 0; i < individual.word_count(); ++i)
+			{
+				std::memcpy(&individual.word(i), input + i * sizeof(uint64_t), sizeof(uint64_t));
+			}
+
+			return individual;
+		}
+	};
+
+	/**
+	 * \brief Rounds a number of bytes up to a multiple of 8.
+	 * \param bytes
+	 * \return
+	 */
+	inline uint64_t checkpoint_align(const uint64_t bytes)
+	{
+		return (bytes + 7) / 8 * 8;
+	}
+
+	/**
+	 * \brief Computes the 64-bit FNV-1a hash of given bytes.
+	 * \param data
+	 * \param size
+	 * \return
+	 */
+	inline uint64_t checkpoint_checksum(const char * data, const size_t size)
+	{
+		uint64_t hash = 0xCBF29CE484222325;
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= static_cast<unsigned char>(data[i]);
+			hash *= 0x100000001B3;
+		}
+
+		return hash;
+	}
+
+	/**
+	 * \brief Converts a run and its population to the contents of a checkpoint file.
+	 *		  The checksum is left zero and is computed by seal_checkpoint, so that it can be done on another thread.
+	 * \remarks All individuals must have genomes of the same length.
+	 * \tparam TPopulation
+	 * \param state
+	 * \param population
+	 * \return
+	 */
+	template<typename TPopulation>
+	std::vector<char> serialize_checkpoint(const CheckpointState<typename TPopulation::value_type::fitness_type> & state, const TPopulation & population)
+	{
+		using individual_type = typename TPopulation::value_type;
+		using fitness_type = typename individual_type::fitness_type;
+		using codec = GenomeCodec<individual_type>;
+
+		static_assert(std::is_trivially_copyable<fitness_type>::value, "Fitness values must be trivially copyable");
+
+		const uint64_t genome_length = population.size() == 0 ? 0 : codec::length(population[0]);
+
+		CheckpointHeader header{};
+		std::memcpy(header.magic, "EACKPT", 6);
+		header.version = checkpoint_version;
+		header.header_bytes = sizeof(CheckpointHeader);
+		header.byte_order = checkpoint_byte_order;
+		header.seed = state.seed;
+		header.run = state.stream.run;
+		header.island = state.stream.island;
+		header.stream_generation = state.stream.generation;
+		header.stream_individual = state.stream.individual;
+		header.rng_position = state.rng_position;
+		header.generation = state.generation;
+		header.evaluations = state.evaluations;
+		header.stagnant_generations = state.stagnant_generations;
+		header.elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(state.elapsed).count();
+		header.finished = state.finished ? 1 : 0;
+		header.stop_reason = static_cast<uint32_t>(state.reason);
+		header.population_size = population.size();
+		header.genome_length = genome_length;
+		header.element_bits = codec::element_bits;
+		header.genome_bytes = checkpoint_align(codec::bytes(genome_length));
+		header.fitness_bytes = sizeof(fitness_type);
+		header.best_fitness_offset = checkpoint_align(sizeof(CheckpointHeader));
+		header.fitness_offset = header.best_fitness_offset + checkpoint_align(sizeof(fitness_type));
+		header.genomes_offset = header.fitness_offset + checkpoint_align(population.size() * sizeof(fitness_type));
+		header.file_bytes = header.genomes_offset + population.size() * header.genome_bytes;
+
+		std::vector<char> data(header.file_bytes, 0);
+		std::memcpy(data.data(), &header, sizeof(CheckpointHeader));
+		std::memcpy(data.data() + header.best_fitness_offset, &state.best_fitness, sizeof(fitness_type));
+
+		for (size_t i = 0; i < population.size(); ++i)
+		{
+			auto & individual = population[i];
+
+			if (codec::length(individual) != genome_length)
+				throw std::invalid_argument("All genomes of a checkpointed population must have the same length");
+
+			const fitness_type fitness = individual.fitness;
+			std::memcpy(data.data() + header.fitness_offset + i * sizeof(fitness_type), &fitness, sizeof(fitness_type));
+			codec::write(individual, data.data() + header.genomes_offset + i * header.genome_bytes);
+		}
+
+		return data;
+	}
+
+	/**
+	 * \brief Computes the checksum of a serialized checkpoint and stores it to its header.
+	 * \param data
+	 */
+	inline void seal_checkpoint(std::vector<char> & data)
+	{
+		const auto checksum = checkpoint_checksum(data.data() + sizeof(CheckpointHeader), data.size() - sizeof(CheckpointHeader));
+		std::memcpy(data.data() + offsetof(CheckpointHeader, checksum), &checksum, sizeof(checksum));
+	}
+
+	/**
+	 * \brief Loads a checkpoint file. Fitness values are restored, so the population does not have to be evaluated.
+	 * \tparam TPopulation
+	 * \param path
+	 * \param state Overwritten with the state of the run
+	 * \return The population
+	 */
+	template<typename TPopulation>
+	TPopulation load_checkpoint(const std::string & path, CheckpointState<typename TPopulation::value_type::fitness_type> & state)
+	{
+		using individual_type = typename TPopulation::value_type;
+		using fitness_type = typename individual_type::fitness_type;
+		using codec = GenomeCodec<individual_type>;
+
+		// The file is mapped, so its contents are not copied to a buffer before they are decoded
+		const MappedFile file(path);
+		const auto data = file.data();
+		CheckpointHeader header{};
+
+		if (file.size() < sizeof(CheckpointHeader))
+			throw std::runtime_error("The checkpoint " + path + " is truncated");
+
+		std::memcpy(&header, data, sizeof(CheckpointHeader));
+
+		if (std::memcmp(header.magic, "EACKPT\0\0", 8) != 0)
+			throw std::runtime_error(path + " is not a checkpoint");
+
+		if (header.version != checkpoint_version || header.header_bytes != sizeof(CheckpointHeader))
+			throw std::runtime_error("The checkpoint " + path + " has an unsupported version " + std::to_string(header.version));
+
+		if (header.byte_order != checkpoint_byte_order)
+			throw std::runtime_error("The checkpoint " + path + " was written on a machine with a different byte order");
+
+		if (header.fitness_bytes != sizeof(fitness_type) || header.element_bits != codec::element_bits
+			|| header.genome_bytes != checkpoint_align(codec::bytes(header.genome_length)))
+			throw std::runtime_error("The checkpoint " + path + " was written for a different type of individuals");
+
+		if (header.file_bytes != file.size()
+			|| header.genomes_offset + header.population_size * header.genome_bytes != header.file_bytes
+			|| header.fitness_offset + header.population_size * sizeof(fitness_type) > header.genomes_offset
+			|| header.best_fitness_offset + sizeof(fitness_type) > header.fitness_offset
+			|| header.best_fitness_offset < sizeof(CheckpointHeader))
+			throw std::runtime_error("The checkpoint " + path + " is truncated");
+
+		if (checkpoint_checksum(data + sizeof(CheckpointHeader), file.size() - sizeof(CheckpointHeader)) != header.checksum)
+			throw std::runtime_error("The checkpoint " + path + " is corrupted");
+
+		state.seed = header.seed;
+		state.stream = StreamId{ header.run, header.island, header.stream_generation, header.stream_individual };
+		state.rng_position = header.rng_position;
+		state.generation = static_cast<size_t>(header.generation);
+		state.evaluations = static_cast<size_t>(header.evaluations);
+		state.stagnant_generations = static_cast<size_t>(header.stagnant_generations);
+		std::memcpy(&state.best_fitness, data + header.best_fitness_offset, sizeof(fitness_type));
+		state.elapsed = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(header.elapsed_ns));
+		state.finished = header.finished != 0;
+		state.reason = static_cast<StopReason>(header.stop_reason);
+
+		TPopulation population{};
+
+		for (size_t i = 0; i < header.population_size; ++i)
+		{
+			auto individual = codec::read(data + header.genomes_offset + i * header.genome_bytes, static_cast<size_t>(header.genome_length));
+			std::memcpy(&individual.fitness, data + header.fitness_offset + i * sizeof(fitness_type), sizeof(fitness_type));
+			population.push_back(std::move(individual));
+		}
+
+		return population;
+	}
+
+	/**
+	 * \brief Whether a file exists and can be opened for reading.
+	 * \param path
+	 * \return
+	 */
+	inline bool checkpoint_exists(const std::string & path)
+	{
+		return static_cast<bool>(std::ifstream(path, std::ios::binary));
+	}
+
+	/**
+	 * \brief Writes checkpoints on a background thread, so that the algorithm only pays for copying the population.
+	 * \remarks If a checkpoint of a path is submitted before the previous one of the same path was written,
+	 *		    only the newer one is written. Every file is written to a temporary file that then replaces the target,
+	 *		    so an interrupted write never destroys the previous checkpoint.
+	 */
+	class CheckpointWriter
+	{
+		std::mutex mutex_;
+		std::condition_variable work_available_;
+		std::condition_variable work_done_;
+		std::map<std::string, std::vector<char>> pending_;
+		bool writing_ = false;
+		bool stopping_ = false;
+		std::string error_;
+		std::thread thread_;
+
+		static bool write_file(const std::string & path, std::vector<char> & data)
+		{
+			seal_checkpoint(data);
+
+			const auto temporary_path = path + ".tmp";
+			const auto file = std::fopen(temporary_path.c_str(), "wb");
+
+			if (file == nullptr)
+			{
+				return false;
+			}
+
+			const auto written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+
+			if (std::fclose(file) != 0 || !written)
+			{
+				return false;
+			}
+
+#ifdef _WIN32
+			// rename does not replace existing files on Windows
+			std::remove(path.c_str());
+#endif
+			return std::rename(temporary_path.c_str(), path.c_str()) == 0;
+		}
+
+		void writer_loop()
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+
+			while (true)
+			{
+				work_available_.wait(lock, [&]() { return stopping_ || !pending_.empty(); });
+
+				if (pending_.empty())
+				{
+					return;
+				}
+
+				auto entry = std::move(*pending_.begin());
+				pending_.erase(pending_.begin());
+				writing_ = true;
+				lock.unlock();
+
+				const auto written = write_file(entry.first, entry.second);
+
+				lock.lock();
+				writing_ = false;
+
+				if (!written && error_.empty())
+				{
+					error_ = "Cannot write the checkpoint " + entry.first;
+				}
+
+				work_done_.notify_all();
+			}
+		}
+
+	public:
+		CheckpointWriter() : thread_([this]() { writer_loop(); }) {}
+
+		CheckpointWriter(const CheckpointWriter &) = delete;
+		CheckpointWriter & operator=(const CheckpointWriter &) = delete;
+
+		/**
+		 * \brief Writes all pending checkpoints and stops the thread.
+		 */
+		~CheckpointWriter()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				stopping_ = true;
+			}
+
+			work_available_.notify_all();
+			thread_.join();
+		}
+
+		/**
+		 * \brief Queues a serialized checkpoint. Does not wait for the write.
+		 * \param path
+		 * \param data Contents created by serialize_checkpoint
+		 */
+		void submit(const std::string & path, std::vector<char> && data)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				pending_[path] = std::move(data);
+			}
+
+			work_available_.notify_one();
+		}
+
+		/**
+		 * \brief Waits until all queued checkpoints are written. Throws if any write failed since the last call.
+		 */
+		void flush()
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			work_done_.wait(lock, [&]() { return pending_.empty() && !writing_; });
+
+			if (!error_.empty())
+			{
+				const auto error = std::move(error_);
+				error_.clear();
+
+				throw std::runtime_error(error);
+			}
+		}
+	};
+}
+#endif // CHECKPOINT_H
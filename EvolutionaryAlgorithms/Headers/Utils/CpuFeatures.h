@@ -0,0 +1,96 @@
+#ifndef CPUFEATURES_H
+#define CPUFEATURES_H
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#define EA_SIMD_X86
+#define EA_TARGET_AVX2
+#define EA_TARGET_AVX512
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define EA_SIMD_X86
+#define EA_TARGET_AVX2 __attribute__((target("avx2")))
+#define EA_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+namespace ea
+{
+	/**
+	 * \brief Instruction sets that kernels with runtime dispatch can use. Every level includes the previous ones.
+	 */
+	enum class SimdLevel
+	{
+		scalar,
+		avx2,
+		avx512
+	};
+
+	/**
+	 * \brief Detects the best instruction set that is supported by both the CPU and the operating system.
+	 * \return
+	 */
+	inline SimdLevel detect_simd_level()
+	{
+#if defined(EA_SIMD_X86) && defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+
+		if (info[0] < 7)
+		{
+			return SimdLevel::scalar;
+		}
+
+		__cpuid(info, 1);
+		const auto avx_enabled = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0;
+
+		if (!avx_enabled)
+		{
+			return SimdLevel::scalar;
+		}
+
+		// The operating system must save the registers on context switches
+		const auto xcr0 = _xgetbv(0);
+		__cpuidex(info, 7, 0);
+
+		if ((info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6)
+		{
+			return SimdLevel::avx512;
+		}
+
+		if ((info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6)
+		{
+			return SimdLevel::avx2;
+		}
+
+		return SimdLevel::scalar;
+#elif defined(EA_SIMD_X86)
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx512f"))
+		{
+			return SimdLevel::avx512;
+		}
+
+		if (__builtin_cpu_supports("avx2"))
+		{
+			return SimdLevel::avx2;
+		}
+
+		return SimdLevel::scalar;
+#else
+		return SimdLevel::scalar;
+#endif
+	}
+
+	/**
+	 * \brief Best supported instruction set. It is detected only once.
+	 * \return
+	 */
+	inline SimdLevel supported_simd_level()
+	{
+		static const auto level = detect_simd_level();
+
+		return level;
+	}
+}
+#endif // CPUFEATURES_H
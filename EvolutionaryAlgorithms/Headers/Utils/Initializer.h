@@ -61,19 +61,20 @@ namespace ea
 
 		// individual_type must contain a container_type typedef
 		using container_type = typename individual_type::container_type;
+		using element_type = typename container_type::value_type;
 
 		TPopulation pop{};
-		const std::uniform_int_distribution<> int_distribution(min, max);
+		std::uniform_int_distribution<> int_distribution(min, max);
 
 		for (size_t i = 0; i < individuals_count; ++i)
 		{
 			// Create container
 			container_type vec = container_creator::ContainerCreator<container_type>::create_container(individual_size);
 
-			// Fill the container with random numbers from a given range
+			// Fill the container with random numbers from a given range, the elements can be narrower than int
 			for (size_t j = 0; j < individual_size; ++j)
 			{
-				vec[j] = int_distribution(ea::rng_gen());
+				vec[j] = static_cast<element_type>(int_distribution(ea::rng_gen()));
 			}
 
 			// Create the individual by moving the container
@@ -95,6 +96,41 @@ namespace ea
 	{
 		return init_pop_uniform_int<TPopulation>(0, 1, individuals_count, individual_size);
 	}
+
+	/**
+	* \brief Creates a random initial population of packed bit individuals (e.g. PackedBitIndividual) with uniformly distributed bits.
+	*		 Bits are generated a whole word at a time.
+	* \tparam TPopulation Type of the population that will be created
+	* \param individuals_count How many individual do we want in the population.
+	* \param individual_size How many bits should every individual contain.
+	* \return Random initial population.
+	*/
+	template<typename TPopulation>
+	TPopulation init_pop_uniform_bits(const size_t individuals_count, const size_t individual_size)
+	{
+		using individual_type = typename TPopulation::value_type;
+
+		TPopulation pop{};
+
+		for (size_t i = 0; i < individuals_count; ++i)
+		{
+			individual_type individual(individual_size);
+
+			for (size_t j = 0; j < individual.word_count(); ++j)
+			{
+				individual.word(j) = ea::rng_word();
+			}
+
+			if (individual.word_count() > 0)
+			{
+				individual.word(individual.word_count() - 1) &= individual.last_word_mask();
+			}
+
+			pop.push_back(std::move(individual));
+		}
+
+		return pop;
+	}
 }
 
 #endif // INITIALIZER_H
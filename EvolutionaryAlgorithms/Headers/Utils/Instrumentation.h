@@ -0,0 +1,301 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <utility>
+
+/**
+ * Counters of events on the hot path are compiled in only if EA_INSTRUMENTATION is defined (for the whole program).
+ * Otherwise EA_COUNT expands to nothing and its arguments are not evaluated.
+ */
+#ifdef EA_INSTRUMENTATION
+#define EA_COUNT(counter, amount) ::ea::count_event(::ea::Counter::counter, static_cast<uint64_t>(amount))
+#else
+#define EA_COUNT(counter, amount) static_cast<void>(0)
+#endif
+
+namespace ea
+{
+	/**
+	 * \brief Events that are counted by the instrumentation.
+	 */
+	enum class Counter
+	{
+		evaluations, // Individuals whose fitness was evaluated
+		mutations, // Genes changed by mutation operators
+		crossovers, // Pairs of individuals recombined by crossover operators
+		selector_draws, // Individuals selected by selectors
+		rng_calls, // 64-bit words and doubles drawn from random streams
+		allocations, // Heap allocations, counted only with EA_DEFINE_COUNTING_OPERATOR_NEW
+		allocated_bytes, // Bytes allocated on the heap, counted only with EA_DEFINE_COUNTING_OPERATOR_NEW
+		bytes_copied // Bytes of genomes copied by selectors and elitism
+	};
+
+	const size_t counters_count = 8;
+
+	using counter_values = std::array<uint64_t, counters_count>;
+
+	/**
+	 * \brief Returns the name of a given counter.
+	 * \param counter
+	 * \return
+	 */
+	inline std::string counter_name(const Counter counter)
+	{
+		switch (counter)
+		{
+		case Counter::evaluations: return "evaluations";
+		case Counter::mutations: return "mutations";
+		case Counter::crossovers: return "crossovers";
+		case Counter::selector_draws: return "selector_draws";
+		case Counter::rng_calls: return "rng_calls";
+		case Counter::allocations: return "allocations";
+		case Counter::allocated_bytes: return "allocated_bytes";
+		case Counter::bytes_copied: return "bytes_copied";
+		}
+
+		return "unknown";
+	}
+
+	/**
+	 * \brief Fixed array of counter slots, one for each thread that counted an event.
+	 * \remarks Every thread increments only its own cache line, so counting never contends. A thread that owns its slot
+	 *		    adds with a relaxed load and store instead of a locked read-modify-write. Slots are never freed,
+	 *		    so counts of finished threads are kept. Threads beyond max_slots share the last slot and add atomically.
+	 *		    Nothing is allocated, so events can be counted inside operator new.
+	 */
+	class CounterRegistry
+	{
+		struct alignas(64) Slot
+		{
+			std::array<std::atomic<uint64_t>, counters_count> values;
+		};
+
+		static const size_t max_slots = 256;
+
+		Slot slots_[max_slots];
+		std::atomic<size_t> used_slots_;
+
+		CounterRegistry() : used_slots_(0)
+		{
+			reset();
+		}
+
+	public:
+		CounterRegistry(const CounterRegistry &) = delete;
+		CounterRegistry & operator=(const CounterRegistry &) = delete;
+
+		static CounterRegistry & instance()
+		{
+			static CounterRegistry registry;
+
+			return registry;
+		}
+
+		/**
+		 * \brief Adds a given amount to a counter of the current thread.
+		 * \param counter
+		 * \param amount
+		 */
+		void add(const Counter counter, const uint64_t amount)
+		{
+			thread_local Slot * slot = nullptr;
+			thread_local bool shared = false;
+
+			if (slot == nullptr)
+			{
+				const auto index = used_slots_.fetch_add(1, std::memory_order_relaxed);
+				shared = index >= max_slots - 1;
+				slot = &slots_[(std::min)(index, max_slots - 1)];
+			}
+
+			auto & value = slot->values[static_cast<size_t>(counter)];
+
+			if (shared)
+			{
+				value.fetch_add(amount, std::memory_order_relaxed);
+			}
+			else
+			{
+				// Only this thread writes the slot, other threads just read it
+				value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+			}
+		}
+
+		/**
+		 * \brief Sums counters of all threads.
+		 * \return
+		 */
+		counter_values collect() const
+		{
+			counter_values totals{};
+			// A copy, std::min would bind the member to a reference and it has no definition
+			const size_t slots_count = max_slots;
+			const auto used_slots = (std::min)(used_slots_.load(std::memory_order_relaxed), slots_count);
+
+			for (size_t i = 0; i < used_slots; ++i)
+			{
+				for (size_t j = 0; j < counters_count; ++j)
+				{
+					totals[j] += slots_[i].values[j].load(std::memory_order_relaxed);
+				}
+			}
+
+			return totals;
+		}
+
+		/**
+		 * \brief Sets all counters to zero. Events counted concurrently with the reset may be lost or may survive it.
+		 */
+		void reset()
+		{
+			for (auto && slot : slots_)
+			{
+				for (auto && value : slot.values)
+				{
+					value.store(0, std::memory_order_relaxed);
+				}
+			}
+		}
+	};
+
+	/**
+	 * \brief Counts an event. Use the EA_COUNT macro instead so that the call is removed when the instrumentation is disabled.
+	 * \param counter
+	 * \param amount
+	 */
+	inline void count_event(const Counter counter, const uint64_t amount)
+	{
+		CounterRegistry::instance().add(counter, amount);
+	}
+
+	/**
+	 * \brief Sums counters of all threads. All values are zero if the instrumentation is disabled.
+	 * \return
+	 */
+	inline counter_values collect_counters()
+	{
+		return CounterRegistry::instance().collect();
+	}
+
+	/**
+	 * \brief Sets counters of all threads to zero.
+	 */
+	inline void reset_counters()
+	{
+		CounterRegistry::instance().reset();
+	}
+
+	/**
+	 * \brief Counters reported by the algorithm after a generation.
+	 * \remarks Counters are shared by all algorithms of the program, so the values include events of other threads
+	 *		    (e.g. concurrent runs of evolve_batch) that happened during the generation.
+	 */
+	struct CounterSnapshot
+	{
+		size_t generation = 0; // Number of generations evolved by the algorithm, including this one
+		counter_values totals{}; // Values since the start of the program or the last reset
+		counter_values generation_values{}; // Values since the previous snapshot of the same algorithm
+	};
+
+	/**
+	 * \brief Function that receives counter snapshots.
+	 */
+	using counter_sink_type = std::function<void(const CounterSnapshot &)>;
+
+	/**
+	 * \brief Sink that writes totals in the Prometheus text format, e.g. for the textfile collector of node_exporter.
+	 * \remarks The file is written to a temporary file that then replaces the target, so readers never see a partial file.
+	 */
+	class PrometheusTextSink
+	{
+		std::string path_;
+		size_t interval_;
+
+	public:
+		/**
+		 * \brief
+		 * \param path Path of the file
+		 * \param interval Every how many generations is the file written
+		 */
+		explicit PrometheusTextSink(std::string path, const size_t interval = 1) : path_(std::move(path)), interval_((std::max)(interval, size_t{ 1 })) {}
+
+		void operator()(const CounterSnapshot & snapshot) const
+		{
+			if (snapshot.generation % interval_ != 0)
+			{
+				return;
+			}
+
+			const auto temporary_path = path_ + ".tmp";
+			const auto file = std::fopen(temporary_path.c_str(), "w");
+
+			if (file == nullptr)
+			{
+				return;
+			}
+
+			std::fprintf(file, "# TYPE ea_generation gauge\nea_generation %llu\n", static_cast<unsigned long long>(snapshot.generation));
+
+			for (size_t i = 0; i < counters_count; ++i)
+			{
+				const auto name = counter_name(static_cast<Counter>(i));
+				std::fprintf(file, "# TYPE ea_%s_total counter\nea_%s_total %llu\n", name.c_str(), name.c_str(), static_cast<unsigned long long>(snapshot.totals[i]));
+			}
+
+			std::fclose(file);
+#ifdef _WIN32
+			// rename does not replace existing files on Windows
+			std::remove(path_.c_str());
+#endif
+			std::rename(temporary_path.c_str(), path_.c_str());
+		}
+	};
+
+	/**
+	 * \brief Number of bytes that are copied with the genome of a given individual.
+	 * \remarks Individuals whose genome is not stored as an array of elements provide their own overloads.
+	 * \tparam TIndividual
+	 * \param individual
+	 * \return
+	 */
+	template<typename TIndividual>
+	size_t genome_bytes(const TIndividual & individual)
+	{
+		return individual.size() * sizeof(typename TIndividual::element_type);
+	}
+}
+
+/**
+ * Prevents inlining of a function.
+ */
+#if defined(_MSC_VER)
+#define EA_NOINLINE __declspec(noinline)
+#else
+#define EA_NOINLINE __attribute__((noinline))
+#endif
+
+/**
+ * Replaces the global operator new and delete with versions that count allocations and allocated bytes.
+ * Must be used in exactly one translation unit of a program that defines EA_INSTRUMENTATION.
+ * The replacements are never inlined, otherwise GCC warns about free called on memory from operator new (-Wmismatched-new-delete).
+ */
+#define EA_DEFINE_COUNTING_OPERATOR_NEW() \
+	EA_NOINLINE void * operator new(const size_t size) \
+	{ \
+		EA_COUNT(allocations, 1); \
+		EA_COUNT(allocated_bytes, size); \
+		if (const auto pointer = std::malloc(size == 0 ? 1 : size)) \
+			return pointer; \
+		throw std::bad_alloc{}; \
+	} \
+	EA_NOINLINE void operator delete(void * pointer) noexcept { std::free(pointer); } \
+	EA_NOINLINE void operator delete(void * pointer, size_t) noexcept { std::free(pointer); }
+#endif // INSTRUMENTATION_H
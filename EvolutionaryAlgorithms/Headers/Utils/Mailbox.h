@@ -0,0 +1,73 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace ea
+{
+	/**
+	 * \brief Lock-free mailbox with any number of senders and a single receiver.
+	 * \tparam TMessage Type of messages
+	 * \remarks Messages are pushed to an intrusive stack with compare-and-swap and the receiver takes all of them at once,
+	 *		    so neither side ever blocks.
+	 */
+	template<typename TMessage>
+	class Mailbox
+	{
+		struct Node
+		{
+			TMessage message;
+			Node * next;
+		};
+
+		std::atomic<Node *> head_{ nullptr };
+
+	public:
+		Mailbox() = default;
+		Mailbox(const Mailbox &) = delete;
+		Mailbox & operator=(const Mailbox &) = delete;
+
+		~Mailbox()
+		{
+			take_all();
+		}
+
+		/**
+		 * \brief Posts a message to the mailbox. Can be called from any thread.
+		 * \param message
+		 */
+		void post(TMessage message)
+		{
+			auto node = new Node{ std::move(message), head_.load(std::memory_order_relaxed) };
+
+			while (!head_.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+			{
+				/* empty */
+			}
+		}
+
+		/**
+		 * \brief Takes all messages that were posted so far. Must be called only from the receiving thread.
+		 * \return Messages in the order in which they were posted
+		 */
+		std::vector<TMessage> take_all()
+		{
+			auto node = head_.exchange(nullptr, std::memory_order_acquire);
+			std::vector<TMessage> messages;
+
+			while (node != nullptr)
+			{
+				messages.push_back(std::move(node->message));
+				const auto next = node->next;
+				delete node;
+				node = next;
+			}
+
+			std::reverse(messages.begin(), messages.end());
+
+			return messages;
+		}
+	};
+}
+#endif // MAILBOX_H
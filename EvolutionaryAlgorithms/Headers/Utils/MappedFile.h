@@ -0,0 +1,171 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+// Keep windows.h from defining the min and max macros and from including rarely used headers in every user of the library
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ea
+{
+	/**
+	 * \brief Read-only memory mapping of a whole file.
+	 * \remarks Pages are loaded by the operating system when they are first read, so nothing is copied to a buffer.
+	 *		    An empty file has no mapping and data() returns nullptr.
+	 */
+	class MappedFile
+	{
+		const char * data_ = nullptr;
+		size_t size_ = 0;
+
+#ifdef _WIN32
+		HANDLE file_ = INVALID_HANDLE_VALUE;
+		HANDLE mapping_ = nullptr;
+#endif
+
+		void close()
+		{
+#ifdef _WIN32
+			if (data_ != nullptr)
+			{
+				UnmapViewOfFile(data_);
+			}
+
+			if (mapping_ != nullptr)
+			{
+				CloseHandle(mapping_);
+			}
+
+			if (file_ != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(file_);
+			}
+
+			file_ = INVALID_HANDLE_VALUE;
+			mapping_ = nullptr;
+#else
+			if (data_ != nullptr)
+			{
+				munmap(const_cast<char *>(data_), size_);
+			}
+#endif
+			data_ = nullptr;
+			size_ = 0;
+		}
+
+	public:
+		/**
+		 * \brief Maps a given file. Throws std::runtime_error if the file cannot be opened or mapped.
+		 * \param path
+		 */
+		explicit MappedFile(const std::string & path)
+		{
+#ifdef _WIN32
+			file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+			if (file_ == INVALID_HANDLE_VALUE)
+				throw std::runtime_error("Cannot open " + path);
+
+			LARGE_INTEGER size;
+
+			if (!GetFileSizeEx(file_, &size))
+			{
+				close();
+				throw std::runtime_error("Cannot read the size of " + path);
+			}
+
+			if (size.QuadPart == 0)
+			{
+				return;
+			}
+
+			mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			data_ = mapping_ == nullptr ? nullptr : static_cast<const char *>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+
+			if (data_ == nullptr)
+			{
+				close();
+				throw std::runtime_error("Cannot map " + path);
+			}
+
+			size_ = static_cast<size_t>(size.QuadPart);
+#else
+			const auto file = open(path.c_str(), O_RDONLY);
+
+			if (file < 0)
+				throw std::runtime_error("Cannot open " + path);
+
+			struct stat status;
+
+			if (fstat(file, &status) != 0)
+			{
+				::close(file);
+				throw std::runtime_error("Cannot read the size of " + path);
+			}
+
+			size_ = static_cast<size_t>(status.st_size);
+
+			if (size_ != 0)
+			{
+				const auto data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+
+				if (data == MAP_FAILED)
+				{
+					::close(file);
+					size_ = 0;
+					throw std::runtime_error("Cannot map " + path);
+				}
+
+				// The whole file is usually read from the beginning to the end
+				madvise(data, size_, MADV_SEQUENTIAL);
+				data_ = static_cast<const char *>(data);
+			}
+
+			// The mapping stays valid after the descriptor is closed
+			::close(file);
+#endif
+		}
+
+		MappedFile(const MappedFile &) = delete;
+		MappedFile & operator=(const MappedFile &) = delete;
+
+		~MappedFile()
+		{
+			close();
+		}
+
+		/**
+		 * \brief Contents of the file.
+		 * \return
+		 */
+		const char * data() const
+		{
+			return data_;
+		}
+
+		/**
+		 * \brief Size of the file in bytes.
+		 * \return
+		 */
+		size_t size() const
+		{
+			return size_;
+		}
+	};
+}
+#endif // MAPPEDFILE_H
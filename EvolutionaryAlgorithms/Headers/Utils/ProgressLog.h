@@ -0,0 +1,446 @@
+#ifndef PROGRESSLOG_H
+#define PROGRESSLOG_H
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Utils/RingBuffer.h"
+#include "Utils/Termination.h"
+
+namespace ea
+{
+	/**
+	 * \brief Kind of a progress record.
+	 */
+	enum class ProgressEvent
+	{
+		generation, // A generation was evolved
+		finished // A run stopped
+	};
+
+	/**
+	 * \brief Progress of a run that is pushed by the algorithm to a ProgressLogger.
+	 * \remarks Records hold only numbers, so pushing one never allocates. Best individuals are published to the logger
+	 *		    separately (see ProgressLogger::publish_individual).
+	 */
+	struct ProgressRecord
+	{
+		ProgressEvent event = ProgressEvent::generation;
+		uint64_t run = 0;
+		uint64_t island = 0;
+		uint64_t generation = 0; // Number of completed generations
+		double objective = 0; // Objective of the best individual
+		double best_fitness = 0;
+		double mean_fitness = 0;
+		double worst_fitness = 0;
+		uint64_t evaluations = 0;
+		int64_t elapsed_ns = 0;
+		StopReason reason = StopReason::generations; // Why the run stopped, only for finished records
+		uint64_t dropped = 0; // Number of records dropped by the logger so far, set when the record is written
+	};
+
+	/**
+	 * \brief Converts an individual published by a run to a string.
+	 */
+	using individual_renderer = std::function<std::string()>;
+
+	/**
+	 * \brief Destination of formatted progress records.
+	 */
+	struct ProgressSink
+	{
+		std::function<void(const ProgressRecord &, const std::string * individual)> write; // individual is nullptr if not rendered
+		std::function<void()> flush; // Called when there are no more records to write, can be empty
+		bool wants_individuals = false;
+	};
+
+	/**
+	 * \brief Appends a number in the shortest form that keeps its value readable.
+	 * \param output
+	 * \param value
+	 */
+	inline void append_number(std::string & output, const double value)
+	{
+		char buffer[32];
+		const auto length = std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+		output.append(buffer, length > 0 ? static_cast<size_t>(length) : 0);
+	}
+
+	/**
+	 * \brief Appends a string as a JSON string literal.
+	 * \param output
+	 * \param value
+	 */
+	inline void append_json_string(std::string & output, const std::string & value)
+	{
+		output += '"';
+
+		for (auto character : value)
+		{
+			switch (character)
+			{
+			case '"': output += "\\\""; break;
+			case '\\': output += "\\\\"; break;
+			case '\n': output += "\\n"; break;
+			case '\t': output += "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(character) < 0x20)
+				{
+					char buffer[8];
+					std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(character));
+					output += buffer;
+				}
+				else
+				{
+					output += character;
+				}
+			}
+		}
+
+		output += '"';
+	}
+
+	/**
+	 * \brief Sink that writes human readable lines in the format of EvolutionaryAlgorithm::evolve. The stream is not flushed after every line.
+	 * \param out Must outlive the logger
+	 * \param individuals Whether the best individual is written
+	 * \return
+	 */
+	inline ProgressSink text_sink(std::ostream & out, const bool individuals = true)
+	{
+		ProgressSink sink;
+		sink.wants_individuals = individuals;
+		sink.flush = [&out]() { out.flush(); };
+		sink.write = [&out, line = std::string()](const ProgressRecord & record, const std::string * individual) mutable {
+			line.clear();
+
+			if (record.event == ProgressEvent::finished)
+			{
+				line += "<< FINISHED >> run: ";
+				append_number(line, static_cast<double>(record.run));
+				line += "; best obj: ";
+				append_number(line, record.objective);
+				line += "; generations: ";
+				append_number(line, static_cast<double>(record.generation));
+				line += "; stopped: ";
+				line += stop_reason_name(record.reason);
+
+				if (record.dropped != 0)
+				{
+					line += "; dropped records: ";
+					append_number(line, static_cast<double>(record.dropped));
+				}
+			}
+			else
+			{
+				line += "run: ";
+				append_number(line, static_cast<double>(record.run));
+				line += "; gen: ";
+				append_number(line, static_cast<double>(record.generation));
+				line += "; obj: ";
+				append_number(line, record.objective);
+				line += "; fitness best/mean/worst: ";
+				append_number(line, record.best_fitness);
+				line += " / ";
+				append_number(line, record.mean_fitness);
+				line += " / ";
+				append_number(line, record.worst_fitness);
+			}
+
+			if (individual != nullptr)
+			{
+				line += "; best ind.: ";
+				line += *individual;
+			}
+
+			line += '\n';
+			out << line;
+		};
+
+		return sink;
+	}
+
+	/**
+	 * \brief Sink that writes one JSON object per line. The stream is not flushed after every line.
+	 * \param out Must outlive the logger
+	 * \param individuals Whether the best individual is written
+	 * \return
+	 */
+	inline ProgressSink jsonl_sink(std::ostream & out, const bool individuals = false)
+	{
+		ProgressSink sink;
+		sink.wants_individuals = individuals;
+		sink.flush = [&out]() { out.flush(); };
+		sink.write = [&out, line = std::string()](const ProgressRecord & record, const std::string * individual) mutable {
+			line.clear();
+			line += record.event == ProgressEvent::finished ? "{\"event\": \"finished\"" : "{\"event\": \"generation\"";
+			line += ", \"run\": ";
+			append_number(line, static_cast<double>(record.run));
+			line += ", \"island\": ";
+			append_number(line, static_cast<double>(record.island));
+			line += ", \"generation\": ";
+			append_number(line, static_cast<double>(record.generation));
+			line += ", \"objective\": ";
+			append_number(line, record.objective);
+			line += ", \"best_fitness\": ";
+			append_number(line, record.best_fitness);
+			line += ", \"mean_fitness\": ";
+			append_number(line, record.mean_fitness);
+			line += ", \"worst_fitness\": ";
+			append_number(line, record.worst_fitness);
+			line += ", \"evaluations\": ";
+			append_number(line, static_cast<double>(record.evaluations));
+			line += ", \"elapsed_ms\": ";
+			append_number(line, record.elapsed_ns / 1e6);
+
+			if (record.event == ProgressEvent::finished)
+			{
+				line += ", \"stopped\": ";
+				append_json_string(line, stop_reason_name(record.reason));
+				line += ", \"dropped_records\": ";
+				append_number(line, static_cast<double>(record.dropped));
+			}
+
+			if (individual != nullptr)
+			{
+				line += ", \"best_individual\": ";
+				append_json_string(line, *individual);
+			}
+
+			line += "}\n";
+			out << line;
+		};
+
+		return sink;
+	}
+
+	/**
+	 * \brief Writes progress records to sinks on a background thread.
+	 * \remarks Algorithms push records to a lock-free ring buffer and do not wait for the output. If the buffer is full,
+	 *		    generation records are dropped and counted, finished records wait until there is space.
+	 *		    Finished records report the number of dropped records. Sinks are called only from the thread of the logger.
+	 */
+	class ProgressLogger
+	{
+		RingBuffer<ProgressRecord> records_;
+		std::vector<ProgressSink> sinks_;
+		bool wants_individuals_ = false;
+
+		// The last individual published by each run and island, replaced as a whole
+		std::map<std::pair<uint64_t, uint64_t>, std::shared_ptr<const individual_renderer>> individuals_;
+		std::mutex individuals_mutex_;
+
+		std::atomic<uint64_t> pushed_{ 0 };
+		std::atomic<uint64_t> written_{ 0 };
+		std::atomic<uint64_t> dropped_{ 0 };
+
+		std::mutex mutex_;
+		std::condition_variable work_available_;
+		std::condition_variable work_done_;
+		bool stopping_ = false;
+		std::thread thread_;
+
+		/**
+		 * \brief Writes all records in the buffer.
+		 * \return Whether any record was written
+		 */
+		bool drain()
+		{
+			ProgressRecord record;
+			std::string individual;
+			auto any = false;
+
+			while (records_.try_pop(record))
+			{
+				std::shared_ptr<const individual_renderer> renderer;
+
+				if (wants_individuals_)
+				{
+					std::lock_guard<std::mutex> lock(individuals_mutex_);
+					const auto found = individuals_.find(std::make_pair(record.run, record.island));
+
+					if (found != individuals_.end())
+					{
+						renderer = found->second;
+					}
+				}
+
+				if (renderer)
+				{
+					individual = (*renderer)();
+				}
+
+				record.dropped = dropped_;
+
+				for (auto && sink : sinks_)
+				{
+					sink.write(record, sink.wants_individuals && renderer ? &individual : nullptr);
+				}
+
+				++written_;
+				any = true;
+			}
+
+			if (any)
+			{
+				for (auto && sink : sinks_)
+				{
+					if (sink.flush)
+					{
+						sink.flush();
+					}
+				}
+			}
+
+			return any;
+		}
+
+		void logger_loop()
+		{
+			while (true)
+			{
+				if (drain())
+				{
+					std::lock_guard<std::mutex> lock(mutex_);
+					work_done_.notify_all();
+				}
+
+				std::unique_lock<std::mutex> lock(mutex_);
+
+				if (stopping_)
+				{
+					// Nothing is pushed once the logger is being destroyed
+					lock.unlock();
+					drain();
+
+					return;
+				}
+
+				// Producers do not take the mutex, so a missed notification is covered by the timeout
+				work_available_.wait_for(lock, std::chrono::milliseconds(10), [&]() { return stopping_ || written_ < pushed_; });
+			}
+		}
+
+	public:
+		/**
+		 * \brief
+		 * \param sinks Destinations of the records
+		 * \param capacity Maximum number of records waiting to be written. Must be a power of two.
+		 */
+		explicit ProgressLogger(std::vector<ProgressSink> sinks, const size_t capacity = 1024) : records_(capacity), sinks_(std::move(sinks))
+		{
+			for (auto && sink : sinks_)
+			{
+				wants_individuals_ = wants_individuals_ || sink.wants_individuals;
+			}
+
+			thread_ = std::thread([this]() { logger_loop(); });
+		}
+
+		ProgressLogger(const ProgressLogger &) = delete;
+		ProgressLogger & operator=(const ProgressLogger &) = delete;
+
+		/**
+		 * \brief Writes all pushed records and stops the thread.
+		 */
+		~ProgressLogger()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				stopping_ = true;
+			}
+
+			work_available_.notify_one();
+			thread_.join();
+		}
+
+		/**
+		 * \brief Whether any sink writes individuals. Algorithms publish their best individuals only if it does.
+		 * \return
+		 */
+		bool wants_individuals() const
+		{
+			return wants_individuals_;
+		}
+
+		/**
+		 * \brief Replaces the individual that is written with the records of a given run and island.
+		 *		  The renderer is called on the thread of the logger when a record of the run is written. Can be called from any thread.
+		 * \param run
+		 * \param island
+		 * \param renderer nullptr removes the individual, e.g. when it refers to objects that do not outlive the run
+		 */
+		void publish_individual(const uint64_t run, const uint64_t island, std::shared_ptr<const individual_renderer> renderer)
+		{
+			std::lock_guard<std::mutex> lock(individuals_mutex_);
+
+			if (renderer)
+			{
+				individuals_[std::make_pair(run, island)] = std::move(renderer);
+			}
+			else
+			{
+				individuals_.erase(std::make_pair(run, island));
+			}
+		}
+
+		/**
+		 * \brief Queues a record. Can be called from any thread. Generation records never wait, finished records
+		 *		  wait for space in the buffer.
+		 * \param record
+		 * \return False if the buffer is full and the record was dropped
+		 */
+		bool push(ProgressRecord record)
+		{
+			while (!records_.try_push(std::move(record)))
+			{
+				if (record.event != ProgressEvent::finished)
+				{
+					++dropped_;
+
+					return false;
+				}
+
+				// A failed push leaves the record untouched, the logger makes space
+				work_available_.notify_one();
+				std::this_thread::yield();
+			}
+
+			++pushed_;
+			work_available_.notify_one();
+
+			return true;
+		}
+
+		/**
+		 * \brief Waits until all records pushed so far are written.
+		 */
+		void flush()
+		{
+			const auto target = pushed_.load();
+			std::unique_lock<std::mutex> lock(mutex_);
+			work_available_.notify_one();
+			work_done_.wait(lock, [&]() { return written_ >= target; });
+		}
+
+		/**
+		 * \brief Number of generation records that were dropped because the buffer was full.
+		 * \return
+		 */
+		uint64_t dropped() const
+		{
+			return dropped_;
+		}
+	};
+}
+#endif // PROGRESSLOG_H
@@ -0,0 +1,290 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "Utils/Instrumentation.h"
+
+namespace ea
+{
+	/**
+	 * \brief Derives the seed of an independent random stream from a master seed.
+	 * \remarks Uses the splitmix64 finalizer so that consecutive streams get uncorrelated seeds.
+	 * \param master_seed
+	 * \param stream Index of the stream, e.g. the index of a run.
+	 * \return
+	 */
+	inline uint64_t derive_seed(const uint64_t master_seed, const uint64_t stream)
+	{
+		auto z = master_seed + (stream + 1) * 0x9E3779B97F4A7C15ULL;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+		return z ^ (z >> 31);
+	}
+
+	/**
+	 * \brief The Philox4x32-10 counter-based generator (Salmon et al., Parallel Random Numbers: As Easy as 1, 2, 3).
+	 * \remarks Maps a 128-bit counter and a 64-bit key to 128 random bits. There is no state besides the counter,
+	 *		    so any position of any stream can be computed directly.
+	 */
+	struct Philox4x32
+	{
+		using counter_type = std::array<uint32_t, 4>;
+		using key_type = std::array<uint32_t, 2>;
+
+		/**
+		 * \brief Computes the random block of a given counter.
+		 * \param counter
+		 * \param key
+		 * \return
+		 */
+		static counter_type block(counter_type counter, key_type key)
+		{
+			for (auto round = 0; round < 10; ++round)
+			{
+				const auto product0 = uint64_t{ 0xD2511F53 } * counter[0];
+				const auto product1 = uint64_t{ 0xCD9E8D57 } * counter[2];
+
+				counter = {
+					static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+					static_cast<uint32_t>(product1),
+					static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+					static_cast<uint32_t>(product0)
+				};
+
+				key[0] += 0x9E3779B9;
+				key[1] += 0xBB67AE85;
+			}
+
+			return counter;
+		}
+	};
+
+	/**
+	 * \brief Coordinates of a random stream within a master seed.
+	 */
+	struct StreamId
+	{
+		static constexpr uint32_t no_individual = (std::numeric_limits<uint32_t>::max)();
+
+		uint64_t run = 0; // Index of the run of a batch
+		uint64_t island = 0; // Index of the island of an island model
+		uint32_t generation = 0; // 0 for the initial population, i + 1 for the i-th evolved generation
+		uint32_t individual = no_individual; // Index of the individual or no_individual for the stream shared by the whole generation
+	};
+
+	/**
+	 * \brief Stream of random numbers produced by the Philox4x32-10 generator.
+	 * \remarks The key is derived from the master seed, the run and the island, the upper half of the counter holds the generation
+	 *		    and the individual and the lower half is the position within the stream. Streams with different coordinates
+	 *		    never overlap, so every part of the algorithm can draw from its own stream no matter which thread runs it.
+	 *		    Unlike std::mt19937, the state is a few words and is cheap to copy.
+	 */
+	class RandomStream
+	{
+		uint64_t seed_ = 0;
+		StreamId id_{};
+		Philox4x32::key_type key_{};
+
+		uint64_t block_index_ = 0;
+		std::array<uint64_t, 2> buffer_{};
+		size_t buffered_ = 0;
+
+		/**
+		 * \brief Computes two 64-bit words of a given block of the stream.
+		 * \param index
+		 * \return
+		 */
+		std::array<uint64_t, 2> generate_block(const uint64_t index) const
+		{
+			const auto block = Philox4x32::block({
+				static_cast<uint32_t>(index),
+				static_cast<uint32_t>(index >> 32),
+				id_.individual,
+				id_.generation
+			}, key_);
+
+			return { (uint64_t{ block[1] } << 32) | block[0], (uint64_t{ block[3] } << 32) | block[2] };
+		}
+
+		/**
+		 * \brief Converts random bits to a double from the interval [0,1) with 53 random bits.
+		 * \param word
+		 * \return
+		 */
+		static double to_unit(const uint64_t word)
+		{
+			return static_cast<double>(word >> 11) * (1.0 / 9007199254740992.0);
+		}
+
+	public:
+		using result_type = uint64_t;
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return (std::numeric_limits<result_type>::max)(); }
+
+		/**
+		 * \brief Creates the stream of the initial population of the first run of a given seed.
+		 * \param seed
+		 */
+		explicit RandomStream(const uint64_t seed = 0) : RandomStream(seed, StreamId{}) {}
+
+		/**
+		 * \brief Creates the stream with given coordinates.
+		 * \param seed Master seed
+		 * \param id
+		 */
+		RandomStream(const uint64_t seed, const StreamId & id)
+		{
+			reset(seed, id);
+		}
+
+		/**
+		 * \brief Jumps to the beginning of the stream with given coordinates.
+		 * \param seed Master seed
+		 * \param id
+		 */
+		void reset(const uint64_t seed, const StreamId & id)
+		{
+			const auto key = derive_seed(derive_seed(seed, id.run), id.island);
+
+			seed_ = seed;
+			id_ = id;
+			key_ = { static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32) };
+			block_index_ = 0;
+			buffered_ = 0;
+		}
+
+		/**
+		 * \brief Jumps to the beginning of the stream of a given generation. The seed, the run and the island are kept.
+		 * \param generation 0 for the initial population, i + 1 for the i-th evolved generation
+		 */
+		void set_generation(const uint32_t generation)
+		{
+			auto id = id_;
+			id.generation = generation;
+			id.individual = StreamId::no_individual;
+			reset(seed_, id);
+		}
+
+		/**
+		 * \brief Creates the stream of a given individual of the current generation.
+		 * \remarks The result does not depend on how many numbers were drawn from this stream,
+		 *		    so individuals can be processed in any order and on any thread.
+		 * \param individual
+		 * \return
+		 */
+		RandomStream split(const uint32_t individual) const
+		{
+			auto id = id_;
+			id.individual = individual;
+
+			return RandomStream(seed_, id);
+		}
+
+		/**
+		 * \brief Master seed of the stream.
+		 * \return
+		 */
+		uint64_t seed() const
+		{
+			return seed_;
+		}
+
+		/**
+		 * \brief Coordinates of the stream.
+		 * \return
+		 */
+		const StreamId & id() const
+		{
+			return id_;
+		}
+
+		/**
+		 * \brief Number of words drawn since the beginning of the stream. reset followed by discard(position()) restores the stream.
+		 * \return
+		 */
+		uint64_t position() const
+		{
+			return block_index_ * 2 - buffered_;
+		}
+
+		/**
+		 * \brief Returns 64 uniformly distributed random bits.
+		 * \return
+		 */
+		result_type operator()()
+		{
+			EA_COUNT(rng_calls, 1);
+
+			if (buffered_ == 0)
+			{
+				buffer_ = generate_block(block_index_++);
+				buffered_ = 2;
+			}
+
+			return buffer_[2 - buffered_--];
+		}
+
+		/**
+		 * \brief Skips a given number of words.
+		 * \param count
+		 */
+		void discard(uint64_t count)
+		{
+			for (; count > 0 && buffered_ > 0; --count)
+			{
+				--buffered_;
+			}
+
+			block_index_ += count / 2;
+
+			if (count % 2 != 0)
+			{
+				(*this)();
+			}
+		}
+
+		/**
+		 * \brief Returns a double from the interval [0,1).
+		 * \return
+		 */
+		double uniform()
+		{
+			return to_unit((*this)());
+		}
+
+		/**
+		 * \brief Fills a buffer with doubles from the interval [0,1).
+		 * \remarks Whole blocks are converted without going through the buffer of single draws.
+		 *		    The values are the same as if uniform was called count times.
+		 * \param output
+		 * \param count
+		 */
+		void fill_uniform(double * output, size_t count)
+		{
+			for (; count > 0 && buffered_ > 0; --count)
+			{
+				*output++ = uniform();
+			}
+
+			// Single draws are counted by operator()
+			EA_COUNT(rng_calls, count - count % 2);
+
+			for (; count >= 2; count -= 2)
+			{
+				const auto block = generate_block(block_index_++);
+				*output++ = to_unit(block[0]);
+				*output++ = to_unit(block[1]);
+			}
+
+			if (count != 0)
+			{
+				*output = uniform();
+			}
+		}
+	};
+}
+#endif // RANDOM_H
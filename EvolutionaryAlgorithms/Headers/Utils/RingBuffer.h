@@ -0,0 +1,135 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace ea
+{
+	/**
+	 * \brief Bounded lock-free queue with any number of producers and consumers.
+	 * \tparam TItem Type of items, must be default constructible and movable
+	 * \remarks Every cell of the ring has a sequence number that tells whether it is free for the producer of a given position
+	 *		    or holds an item for the consumer of that position (D. Vyukov's bounded queue). Positions are claimed with
+	 *		    compare-and-swap, so neither side ever blocks. A full queue rejects new items instead of waiting.
+	 */
+	template<typename TItem>
+	class RingBuffer
+	{
+		struct Cell
+		{
+			std::atomic<size_t> sequence;
+			TItem item;
+		};
+
+		std::unique_ptr<Cell[]> cells_;
+		size_t mask_;
+
+		// Producers and the consumer work with different cache lines
+		alignas(64) std::atomic<size_t> enqueue_position_{ 0 };
+		alignas(64) std::atomic<size_t> dequeue_position_{ 0 };
+
+	public:
+		/**
+		 * \brief
+		 * \param capacity Maximum number of items in the queue. Must be a power of two.
+		 */
+		explicit RingBuffer(const size_t capacity) : cells_(new Cell[capacity]), mask_(capacity - 1)
+		{
+			if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+				throw std::invalid_argument("The capacity must be a power of two");
+
+			for (size_t i = 0; i < capacity; ++i)
+			{
+				cells_[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		RingBuffer(const RingBuffer &) = delete;
+		RingBuffer & operator=(const RingBuffer &) = delete;
+
+		/**
+		 * \brief Adds an item to the queue. Can be called from any thread.
+		 * \param item
+		 * \return False if the queue is full. The item is not moved then.
+		 */
+		bool try_push(TItem && item)
+		{
+			auto position = enqueue_position_.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				auto & cell = cells_[position & mask_];
+				const auto sequence = cell.sequence.load(std::memory_order_acquire);
+				const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+				if (difference == 0)
+				{
+					if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						cell.item = std::move(item);
+						cell.sequence.store(position + 1, std::memory_order_release);
+
+						return true;
+					}
+				}
+				else if (difference < 0)
+				{
+					return false;
+				}
+				else
+				{
+					position = enqueue_position_.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/**
+		 * \brief Takes the oldest item from the queue. Can be called from any thread.
+		 * \param item Overwritten with the item
+		 * \return False if the queue is empty
+		 */
+		bool try_pop(TItem & item)
+		{
+			auto position = dequeue_position_.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				auto & cell = cells_[position & mask_];
+				const auto sequence = cell.sequence.load(std::memory_order_acquire);
+				const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+				if (difference == 0)
+				{
+					if (dequeue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						item = std::move(cell.item);
+						cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+
+						return true;
+					}
+				}
+				else if (difference < 0)
+				{
+					return false;
+				}
+				else
+				{
+					position = dequeue_position_.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/**
+		 * \brief Maximum number of items in the queue.
+		 * \return
+		 */
+		size_t capacity() const
+		{
+			return mask_ + 1;
+		}
+	};
+}
+#endif // RINGBUFFER_H
@@ -0,0 +1,156 @@
+#ifndef RUNCONTROL_H
+#define RUNCONTROL_H
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+
+namespace ea
+{
+	/**
+	 * \brief The best individual found so far by a run that is controlled by a RunControl.
+	 * \tparam TIndividual
+	 * \tparam TObjective
+	 */
+	template<typename TIndividual, typename TObjective>
+	struct BestSnapshot
+	{
+		TIndividual individual;
+		TObjective objective;
+		size_t generation; // Number of generations evolved when the individual was found
+	};
+
+	/**
+	 * \brief State that is shared between a running algorithm and other threads.
+	 *		  Other threads can cancel the run, move its deadline and read the best individual found so far at any time.
+	 * \remarks The algorithm checks the cancellation between the stages of a generation. If an individual fitness function is set,
+	 *		    it is also checked before the evaluation of every individual, otherwise before every call of the population fitness
+	 *		    function, which gets the whole population or, with fitness threads, one chunk per thread. After the run is cancelled
+	 *		    or the deadline passes, it returns when the operator or selector in progress finishes, or when every fitness thread
+	 *		    finishes the individual (or the chunk) it is evaluating.
+	 *		    Algorithms that share a control (e.g. the runs of evolve_batch or islands) are all cancelled and publish
+	 *		    to the same best individual.
+	 * \tparam TIndividual
+	 * \tparam TObjective
+	 */
+	template<typename TIndividual, typename TObjective>
+	class RunControl
+	{
+	public:
+		using clock = std::chrono::steady_clock;
+		using snapshot_type = BestSnapshot<TIndividual, TObjective>;
+
+	private:
+		std::atomic<bool> cancel_requested_{ false };
+		std::atomic<clock::rep> deadline_{ (std::numeric_limits<clock::rep>::max)() };
+
+		// Snapshots are immutable and replaced as a whole, so readers never block the run
+		std::shared_ptr<const snapshot_type> best_;
+
+	public:
+		RunControl() = default;
+		RunControl(const RunControl &) = delete;
+		RunControl & operator=(const RunControl &) = delete;
+
+		/**
+		 * \brief Asks the run to stop as soon as possible. Can be called from any thread.
+		 */
+		void cancel()
+		{
+			cancel_requested_.store(true, std::memory_order_relaxed);
+		}
+
+		/**
+		 * \brief Whether cancel was called.
+		 * \return
+		 */
+		bool cancel_requested() const
+		{
+			return cancel_requested_.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * \brief Sets the time at which the run stops. Can be called from any thread.
+		 * \param deadline
+		 */
+		void set_deadline(const clock::time_point deadline)
+		{
+			deadline_.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
+		}
+
+		/**
+		 * \brief Returns the time at which the run stops, clock::time_point::max() if no deadline is set.
+		 * \return
+		 */
+		clock::time_point deadline() const
+		{
+			return clock::time_point(clock::duration(deadline_.load(std::memory_order_relaxed)));
+		}
+
+		/**
+		 * \brief Sets the deadline to a given time from now.
+		 * \param budget
+		 */
+		void set_time_budget(const clock::duration budget)
+		{
+			set_deadline(clock::now() + budget);
+		}
+
+		/**
+		 * \brief Whether the deadline has passed. Always false if no deadline is set.
+		 * \return
+		 */
+		bool deadline_passed() const
+		{
+			const auto deadline = deadline_.load(std::memory_order_relaxed);
+
+			return deadline != (std::numeric_limits<clock::rep>::max)() && clock::now().time_since_epoch().count() >= deadline;
+		}
+
+		/**
+		 * \brief Whether the run should stop, i.e. it was cancelled or the deadline has passed.
+		 * \return
+		 */
+		bool stop_requested() const
+		{
+			return cancel_requested() || deadline_passed();
+		}
+
+		/**
+		 * \brief Returns the best individual published so far or nullptr if there is none. Can be called from any thread.
+		 * \return
+		 */
+		std::shared_ptr<const snapshot_type> best() const
+		{
+			return std::atomic_load(&best_);
+		}
+
+		/**
+		 * \brief Publishes an individual if its fitness is better than the fitness of the published one.
+		 * \param individual
+		 * \param objective
+		 * \param generation
+		 */
+		void publish(const TIndividual & individual, const TObjective objective, const size_t generation)
+		{
+			auto current = std::atomic_load(&best_);
+
+			if (current && !(current->individual.fitness < individual.fitness))
+			{
+				return;
+			}
+
+			std::shared_ptr<const snapshot_type> snapshot = std::make_shared<snapshot_type>(snapshot_type{ individual, objective, generation });
+
+			// Another algorithm may publish concurrently, so the snapshot is stored only if it is still the better one
+			while (!std::atomic_compare_exchange_weak(&best_, &current, snapshot))
+			{
+				if (current && !(current->individual.fitness < individual.fitness))
+				{
+					return;
+				}
+			}
+		}
+	};
+}
+#endif // RUNCONTROL_H
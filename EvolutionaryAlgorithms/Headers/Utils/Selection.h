@@ -0,0 +1,85 @@
+#ifndef SELECTION_H
+#define SELECTION_H
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace ea
+{
+	/**
+	 * \brief Computes how many individuals should a given selector select if the selection is split among multiple selectors.
+	 * \param selector_order
+	 * \param total_selectors
+	 * \param elements_to_select
+	 * \return
+	 */
+	inline size_t how_many_should_select(const size_t selector_order, const size_t total_selectors, const size_t elements_to_select)
+	{
+		const auto each = static_cast<size_t>(std::floor(elements_to_select / static_cast<double>(total_selectors)));
+
+		if (selector_order < total_selectors - 1)
+		{
+			return each;
+		}
+
+		return elements_to_select - (total_selectors - 1) * each;
+	}
+
+	/**
+	 * \brief Moves the (fitness, index) pairs of the best individuals to the front of a given array, the best one first.
+	 *		  Only the fitness values are copied, so the cost is O(N + k log k) with no copies of individuals.
+	 * \tparam TPopulation
+	 * \tparam TFitness
+	 * \param population
+	 * \param elite_count How many best individuals should be found
+	 * \param candidates Array that is overwritten with (fitness, index) pairs of all individuals. Its storage is reused.
+	 */
+	template<typename TPopulation, typename TFitness>
+	void select_elites(const TPopulation & population, const size_t elite_count, std::vector<std::pair<TFitness, size_t>> & candidates)
+	{
+		candidates.resize(population.size());
+
+		for (size_t i = 0; i < population.size(); ++i)
+		{
+			candidates[i] = std::make_pair(population[i].fitness, i);
+		}
+
+		if (elite_count == 0)
+		{
+			return;
+		}
+
+		// Ties are broken by the index so that the elites do not depend on the standard library implementation
+		const auto better = [](const std::pair<TFitness, size_t> & c1, const std::pair<TFitness, size_t> & c2)
+		{
+			return c1.first > c2.first || (!(c2.first > c1.first) && c1.second < c2.second);
+		};
+
+		std::nth_element(candidates.begin(), candidates.begin() + (elite_count - 1), candidates.end(), better);
+		std::sort(candidates.begin(), candidates.begin() + elite_count, better);
+	}
+
+	/**
+	 * \brief Finds the index of the best individual. Only fitness values are compared.
+	 * \tparam TPopulation
+	 * \param population
+	 * \return
+	 */
+	template<typename TPopulation>
+	size_t find_best_index(const TPopulation & population)
+	{
+		size_t best = 0;
+
+		for (size_t i = 1; i < population.size(); ++i)
+		{
+			if (population[best].fitness < population[i].fitness)
+			{
+				best = i;
+			}
+		}
+
+		return best;
+	}
+}
+#endif // SELECTION_H
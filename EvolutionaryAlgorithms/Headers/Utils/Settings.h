@@ -1,5 +1,8 @@
 ﻿#ifndef SETTINGS_H
 #define SETTINGS_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
 
 namespace ea
 {
@@ -10,6 +13,15 @@ namespace ea
 		double elitism = 0; // The percentage of the best individuals to keep
 		size_t output_frequency = 1; // How often do we want to show the progress
 		size_t number_of_runs = 1; // How many times do we want to run the algorithm
+		size_t fitness_threads = 1; // How many threads evaluate the fitness function
+		size_t batch_threads = 1; // How many runs are executed concurrently
+		uint64_t seed = 0; // Master seed of all random streams, 0 picks a random seed for every batch
+		size_t stagnation_generations = 0; // Stop a run when the best fitness does not improve for this many generations, 0 disables it
+		size_t max_evaluations = 0; // Stop a run after this many fitness evaluations, 0 disables it
+		size_t time_limit_ms = 0; // Stop a run after this many milliseconds, 0 disables it
+		std::string checkpoint_path; // Path prefix of checkpoints of runs, empty disables checkpoints
+		size_t checkpoint_generations = 0; // Every how many generations is a checkpoint written, 0 disables it
+		size_t checkpoint_interval_s = 0; // Every how many seconds is a checkpoint written, 0 disables it
 	};
 }
 #endif // SETTINGS_H
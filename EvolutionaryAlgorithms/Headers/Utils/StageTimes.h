@@ -0,0 +1,113 @@
+#ifndef STAGETIMES_H
+#define STAGETIMES_H
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ea
+{
+	/**
+	 * \brief Stages of a generation of the evolutionary algorithm.
+	 */
+	enum class Stage
+	{
+		mating_selection, // All mating selectors
+		operation, // A single operator, identified by the order of registration
+		fitness, // The fitness function
+		elitism, // Ranking and copying the elites
+		natural_selection, // All natural selectors and the search for the best individual
+		generation // The whole generation
+	};
+
+	/**
+	 * \brief Function that is called with the stage, the index of the operator (0 for other stages) and the duration in nanoseconds.
+	 */
+	using stage_observer_type = std::function<void(Stage, size_t, uint64_t)>;
+
+	/**
+	 * \brief Returns the name of a given stage.
+	 * \param stage
+	 * \return
+	 */
+	inline std::string stage_name(const Stage stage)
+	{
+		switch (stage)
+		{
+		case Stage::mating_selection: return "mating_selection";
+		case Stage::operation: return "operator";
+		case Stage::fitness: return "fitness";
+		case Stage::elitism: return "elitism";
+		case Stage::natural_selection: return "natural_selection";
+		case Stage::generation: return "generation";
+		}
+
+		return "unknown";
+	}
+
+	/**
+	 * \brief Collects durations of stages reported by the algorithm, one sample per stage and generation.
+	 */
+	class StageTimes
+	{
+	public:
+		struct Entry
+		{
+			Stage stage;
+			size_t index;
+			std::vector<double> nanoseconds;
+		};
+
+	private:
+		std::vector<Entry> entries_;
+
+	public:
+		/**
+		 * \brief Adds a sample of a given stage.
+		 * \param stage
+		 * \param index Index of the operator, 0 for other stages
+		 * \param nanoseconds
+		 */
+		void record(const Stage stage, const size_t index, const uint64_t nanoseconds)
+		{
+			// There are only a few stages, so a linear search is cheaper than a map
+			for (auto && entry : entries_)
+			{
+				if (entry.stage == stage && entry.index == index)
+				{
+					entry.nanoseconds.push_back(static_cast<double>(nanoseconds));
+					return;
+				}
+			}
+
+			entries_.push_back(Entry{ stage, index, { static_cast<double>(nanoseconds) } });
+		}
+
+		/**
+		 * \brief Returns an observer that records samples into this object. The object must outlive the observer.
+		 * \return
+		 */
+		stage_observer_type observer()
+		{
+			return [this](const Stage stage, const size_t index, const uint64_t nanoseconds) { record(stage, index, nanoseconds); };
+		}
+
+		/**
+		 * \brief Samples of all stages in the order in which the stages were first reported.
+		 * \return
+		 */
+		const std::vector<Entry> & entries() const
+		{
+			return entries_;
+		}
+
+		/**
+		 * \brief Removes all samples.
+		 */
+		void clear()
+		{
+			entries_.clear();
+		}
+	};
+}
+#endif // STAGETIMES_H
@@ -0,0 +1,80 @@
+#ifndef TERMINATION_H
+#define TERMINATION_H
+#include <chrono>
+#include <string>
+
+namespace ea
+{
+	/**
+	 * \brief Why a run of the evolutionary algorithm stopped.
+	 */
+	enum class StopReason
+	{
+		generations, // The requested number of generations was evolved
+		optimum, // The objective reached a bound that cannot be improved
+		target_objective, // The objective reached the target
+		stagnation, // The best fitness did not improve for the configured number of generations
+		evaluations, // The maximum number of fitness evaluations was reached
+		time_limit, // The time limit of the run was exceeded
+		stop_condition, // A custom stop condition was met
+		deadline, // The deadline of the run control passed
+		cancelled // The run was cancelled through the run control
+	};
+
+	/**
+	 * \brief Returns a human readable description of a given stop reason.
+	 * \param reason
+	 * \return
+	 */
+	inline std::string stop_reason_name(const StopReason reason)
+	{
+		switch (reason)
+		{
+		case StopReason::generations: return "generations";
+		case StopReason::optimum: return "optimum";
+		case StopReason::target_objective: return "target objective";
+		case StopReason::stagnation: return "stagnation";
+		case StopReason::evaluations: return "evaluations";
+		case StopReason::time_limit: return "time limit";
+		case StopReason::stop_condition: return "stop condition";
+		case StopReason::deadline: return "deadline";
+		case StopReason::cancelled: return "cancelled";
+		}
+
+		return "unknown";
+	}
+
+	/**
+	 * \brief Whether a smaller or a bigger objective value is better.
+	 */
+	enum class ObjectiveDirection
+	{
+		minimize,
+		maximize
+	};
+
+	/**
+	 * \brief State of a run that is passed to custom stop conditions after every generation.
+	 * \tparam TObjective Type of the objective value
+	 */
+	template<typename TObjective>
+	struct RunProgress
+	{
+		size_t generation; // Number of generations evolved so far
+		size_t evaluations; // Number of fitness evaluations so far
+		size_t stagnant_generations; // Number of generations since the best fitness last improved
+		TObjective best_objective; // Objective of the best individual of the current population
+		std::chrono::steady_clock::duration elapsed; // Time since the start of the run
+	};
+
+	/**
+	 * \brief Summary of a finished run.
+	 */
+	struct RunResult
+	{
+		StopReason reason = StopReason::generations;
+		size_t generations = 0; // Number of generations evolved
+		size_t evaluations = 0; // Number of fitness evaluations
+	};
+}
+#endif // TERMINATION_H
@@ -0,0 +1,185 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace ea
+{
+	/**
+	 * \brief Fork-join pool of worker threads that is created once and reused for every parallel loop.
+	 * \remarks The calling thread takes part in the work, so a pool created for n threads spawns n - 1 workers.
+	 *		    Concurrent calls of parallel_for from different threads are serialized.
+	 */
+	class ThreadPool
+	{
+		using body_type = std::function<void(size_t, size_t)>;
+
+		std::vector<std::thread> workers_;
+
+		std::mutex call_mutex_;
+		std::mutex mutex_;
+		std::condition_variable work_available_;
+		std::condition_variable work_done_;
+
+		const body_type * body_ = nullptr;
+		size_t count_ = 0;
+		size_t chunks_count_ = 0;
+		std::atomic<size_t> next_chunk_{ 0 };
+		size_t job_id_ = 0;
+		size_t finished_workers_ = 0;
+		bool stopping_ = false;
+		std::exception_ptr exception_;
+
+		/**
+		 * \brief Claims chunks of the current job until there are none left.
+		 */
+		void run_chunks()
+		{
+			for (auto chunk = next_chunk_++; chunk < chunks_count_; chunk = next_chunk_++)
+			{
+				const auto begin = chunk * count_ / chunks_count_;
+				const auto end = (chunk + 1) * count_ / chunks_count_;
+
+				try
+				{
+					(*body_)(begin, end);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(mutex_);
+
+					if (!exception_)
+					{
+						exception_ = std::current_exception();
+					}
+				}
+			}
+		}
+
+		void worker_loop()
+		{
+			size_t seen_job_id = 0;
+
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock(mutex_);
+					work_available_.wait(lock, [&]() { return stopping_ || job_id_ != seen_job_id; });
+
+					if (stopping_)
+					{
+						return;
+					}
+
+					seen_job_id = job_id_;
+				}
+
+				run_chunks();
+
+				{
+					std::lock_guard<std::mutex> lock(mutex_);
+
+					if (++finished_workers_ == workers_.size())
+					{
+						work_done_.notify_one();
+					}
+				}
+			}
+		}
+
+	public:
+		/**
+		 * \brief
+		 * \param threads Total number of threads that work on each parallel loop, including the calling thread.
+		 */
+		explicit ThreadPool(const size_t threads)
+		{
+			if (threads == 0)
+				throw std::invalid_argument("threads must be at least 1");
+
+			for (size_t i = 0; i < threads - 1; ++i)
+			{
+				workers_.emplace_back([this]() { worker_loop(); });
+			}
+		}
+
+		ThreadPool(const ThreadPool &) = delete;
+		ThreadPool & operator=(const ThreadPool &) = delete;
+
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				stopping_ = true;
+			}
+
+			work_available_.notify_all();
+
+			for (auto && worker : workers_)
+			{
+				worker.join();
+			}
+		}
+
+		/**
+		 * \brief Number of threads that take part in each parallel loop.
+		 * \return
+		 */
+		size_t size() const
+		{
+			return workers_.size() + 1;
+		}
+
+		/**
+		 * \brief Splits [0, count) into contiguous chunks and processes them on all threads of the pool.
+		 *		  Returns after every chunk is processed. The first exception thrown by the body is rethrown.
+		 * \param count Number of elements to process.
+		 * \param body Function that is called with the [begin, end) range of each chunk.
+		 */
+		void parallel_for(const size_t count, const body_type & body)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			std::lock_guard<std::mutex> call_lock(call_mutex_);
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				body_ = &body;
+				count_ = count;
+				chunks_count_ = (std::min)(count, 4 * size());
+				next_chunk_ = 0;
+				finished_workers_ = 0;
+				exception_ = nullptr;
+				++job_id_;
+			}
+
+			work_available_.notify_all();
+			run_chunks();
+
+			std::exception_ptr exception;
+
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				work_done_.wait(lock, [&]() { return finished_workers_ == workers_.size(); });
+				body_ = nullptr;
+				exception = exception_;
+			}
+
+			if (exception)
+			{
+				std::rethrow_exception(exception);
+			}
+		}
+	};
+}
+#endif // THREADPOOL_H
@@ -1,19 +1,93 @@
 #ifndef UTILS_H
 #define UTILS_H
+#include <cstdint>
 #include <random>
+#include "Utils/Random.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 namespace ea
 {
 	/**
-	 * \brief Returns the mersenne twister generator for the current thread.
+	 * \brief Returns the random stream of the current thread.
+	 * \remarks Until rng_seed is called, the stream is keyed by a random seed.
 	 * \return 
 	 */
-	inline std::mt19937 & rng_gen()
+	inline RandomStream & rng_gen()
 	{
-		thread_local std::random_device rd;
-		thread_local auto generator = std::mt19937(rd());
+		thread_local auto generator = RandomStream((static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}());
 
 		return generator;
 	}
+
+	/**
+	 * \brief Returns 64 uniformly distributed random bits from the generator of the current thread.
+	 * \return 
+	 */
+	inline uint64_t rng_word()
+	{
+		return rng_gen()();
+	}
+
+	/**
+	 * \brief Counts bits that are set to one.
+	 * \param word 
+	 * \return 
+	 */
+	inline int popcount(const uint64_t word)
+	{
+#if defined(_MSC_VER)
+		return static_cast<int>(__popcnt(static_cast<uint32_t>(word)) + __popcnt(static_cast<uint32_t>(word >> 32)));
+#elif defined(__GNUC__)
+		return __builtin_popcountll(word);
+#else
+		auto x = word - ((word >> 1) & 0x5555555555555555ULL);
+		x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+		x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+		return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+	}
+
+	/**
+	 * \brief Index of the least significant bit that is set to one.
+	 * \param word Must not be zero
+	 * \return 
+	 */
+	inline int count_trailing_zeros(const uint64_t word)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, word);
+
+		return static_cast<int>(index);
+#elif defined(__GNUC__)
+		return __builtin_ctzll(word);
+#else
+		return popcount((word & (~word + 1)) - 1);
+#endif
+	}
+
+	/**
+	 * \brief Moves the generator of the current thread to the stream with given coordinates.
+	 * \param seed Master seed
+	 * \param id 
+	 */
+	inline void rng_seed(const uint64_t seed, const StreamId & id = StreamId{})
+	{
+		rng_gen().reset(seed, id);
+	}
+
+	/**
+	 * \brief Moves the generator of the current thread to the stream of a given generation of its current run and island.
+	 * \remarks Called by the algorithms before every generation, so the random numbers of a generation do not depend
+	 *		    on how many numbers were drawn before it.
+	 * \param generation 0 for the initial population, i + 1 for the i-th evolved generation
+	 */
+	inline void rng_generation(const size_t generation)
+	{
+		rng_gen().set_generation(static_cast<uint32_t>(generation));
+	}
 }
 #endif // UTILS_H
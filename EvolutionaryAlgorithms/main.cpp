@@ -33,6 +33,7 @@ int main()
 		settings.mutation_probability = 0.6;
 		settings.crossover_probability = 0.2;
 		settings.gene_change_probability = 0.001;
+		settings.gene_sampling = ea::GeneSampling::skip;
 		settings.output_frequency = 500;
 		settings.number_of_runs = 5;
 		settings.bins_count = 7;
@@ -0,0 +1,171 @@
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BinPacking/BinPacking.h"
+#include "SGA/SGA.h"
+#include "Utils/Benchmarks.h"
+
+namespace
+{
+	const size_t warmup_generations = 10;
+
+	/**
+	 * \brief Evolves a population for a few generations without timing and then records the time of every stage.
+	 * \tparam TPopulation
+	 * \param ea
+	 * \param population The initial population
+	 * \param generations How many generations are timed
+	 * \return
+	 */
+	template<typename TPopulation>
+	ea::StageTimes time_stages(ea::EvolutionaryAlgorithm<TPopulation> & ea, TPopulation population, const size_t generations)
+	{
+		ea::StageTimes times;
+		TPopulation next_pop{};
+
+		for (size_t i = 0; i < warmup_generations + generations; ++i)
+		{
+			if (i == warmup_generations)
+			{
+				ea.set_stage_observer(times.observer());
+			}
+
+			ea.evolve(population, next_pop);
+			std::swap(population, next_pop);
+		}
+
+		ea.set_stage_observer(nullptr);
+
+		return times;
+	}
+
+	/**
+	 * \brief Times the stages of the simple genetic algorithm configured as in solve_sga.
+	 */
+	void benchmark_sga(const size_t pop_size, const size_t genome_length, const size_t threads, const size_t generations, std::vector<ea::StageBenchmarkRow> & rows)
+	{
+		using individual_type = ea::PackedBitIndividual<int>;
+		using population_type = std::vector<individual_type>;
+
+		sga::SGASettings settings;
+		ea::EvolutionaryAlgorithm<population_type> ea{};
+
+		ea.add_operator(ea::BitFlipMutation<population_type>{settings.bit_mutation_probability, settings.gene_sampling});
+		ea.add_operator(ea::OnePtXOver<population_type>{settings.crossover_probability});
+		ea.add_mating_selector(ea::RouletteWheelSelector<population_type>{});
+		ea.set_individual_fitness(sga::OneMaxFitness<population_type>{});
+		ea.set_fitness_threads(threads);
+		ea.set_elitism(0.01);
+
+		ea::rng_seed(1);
+		auto population = ea::init_pop_uniform_bits<population_type>(pop_size, genome_length);
+		ea.evaluate(population);
+
+		ea::add_stage_rows(time_stages(ea, population, generations), "sga", pop_size, genome_length, threads, rows);
+	}
+
+	/**
+	 * \brief Times the stages of the bin packing algorithm configured as in main.
+	 *		  The weights are repeated or truncated to get the requested number of items.
+	 */
+	void benchmark_bin_packing(const std::vector<int> & weights, const size_t pop_size, const size_t genome_length, const size_t threads, const size_t generations, std::vector<ea::StageBenchmarkRow> & rows)
+	{
+		using individual_type = bin_packing::BinPackingIndividual<std::vector<int>, double>;
+		using population_type = ea::RecyclingPopulation<individual_type>;
+
+		bin_packing::BinPackingSettings settings;
+		settings.mutation_probability = 0.6;
+		settings.crossover_probability = 0.2;
+		settings.gene_change_probability = 0.001;
+		settings.gene_sampling = ea::GeneSampling::skip;
+		settings.bins_count = 7;
+		settings.elitism = 0.05;
+		settings.fitness_threads = threads;
+
+		std::vector<int> items(genome_length);
+
+		for (size_t i = 0; i < genome_length; ++i)
+		{
+			items[i] = weights[i % weights.size()];
+		}
+
+		bin_packing::BinPackingFitness<population_type> fitness(items, settings.bins_count);
+		auto ea = bin_packing::create_algorithm(fitness, settings);
+
+		ea::rng_seed(1);
+		auto population = ea::init_pop_uniform_int<population_type>(0, settings.bins_count - 1, pop_size, genome_length);
+		ea.evaluate(population);
+
+		ea::add_stage_rows(time_stages(ea, population, generations), "bin_packing", pop_size, genome_length, threads, rows);
+	}
+}
+
+/**
+ * \brief Times every stage of a generation for both shipped problems over a sweep of population sizes, genome lengths and fitness threads.
+ *		  Usage: StageBenchmarks [csv|json] [generations] [path to weights of items]
+ *		  The report is written to the standard output, the progress to the standard error.
+ */
+int main(int argc, char * argv[])
+{
+	const std::string format = argc > 1 ? argv[1] : "csv";
+	const size_t generations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+	const std::string path = argc > 3 ? argv[3] : "../EvolutionaryAlgorithms/packingInput-harder.txt";
+
+	if ((format != "csv" && format != "json") || generations == 0)
+	{
+		std::cerr << "Usage: StageBenchmarks [csv|json] [generations] [path to weights of items]" << std::endl;
+		return 1;
+	}
+
+	std::vector<int> weights;
+
+	try
+	{
+		weights = bin_packing::load_weights(path, 0);
+	}
+	catch (const std::exception & e)
+	{
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+
+	const std::vector<size_t> pop_sizes{ 100, 1000 };
+	const std::vector<size_t> genome_lengths{ 100, 1000, 10000 };
+	const auto max_threads = (std::max)(1u, std::thread::hardware_concurrency());
+	std::vector<size_t> threads_counts;
+
+	for (size_t threads = 1; threads <= max_threads; threads *= 2)
+	{
+		threads_counts.push_back(threads);
+	}
+
+	std::vector<ea::StageBenchmarkRow> rows;
+
+	for (auto pop_size : pop_sizes)
+	{
+		for (auto genome_length : genome_lengths)
+		{
+			for (auto threads : threads_counts)
+			{
+				std::cerr << "pop_size: " << pop_size << ", genome_length: " << genome_length << ", threads: " << threads << std::endl;
+
+				benchmark_sga(pop_size, genome_length, threads, generations, rows);
+				benchmark_bin_packing(weights, pop_size, genome_length, threads, generations, rows);
+			}
+		}
+	}
+
+	if (format == "json")
+	{
+		ea::write_stage_json(rows, std::cout);
+	}
+	else
+	{
+		ea::write_stage_csv(rows, std::cout);
+	}
+
+	return 0;
+}